@@ -0,0 +1,314 @@
+// Benchmark : boucle série vs ordonnancement en deux phases sur un bus
+// -------------------------------------------------------------
+// Capteurs simulés (virtual_devices.hpp) sur un bus I2C modélisé, pilotés
+// par les drivers réels : bmp390::Bmp390 en mode forced et hdc3022::Hdc3022.
+//
+// Compare, à nombre de cycles égal :
+//  - la boucle série de mainLoop() : update() bloque le bus pendant chaque
+//    conversion ;
+//  - multisensor::BusScheduler : trigger() de tous les capteurs, puis
+//    collect() dès la fin de chaque conversion.
+//
+// Le temps de cycle est mesuré en temps virtuel (ce que verrait le bus réel),
+// le coût CPU de l'hôte en temps réel.
+//
+// Usage : bus_scheduling_benchmark [bmp390=4] [hdc3022=2] [cycles=200] [i2c_khz=400]
+// Compilation (exemple, depuis la racine du dépôt ; bmp3.c est compilé en C à part) :
+//   gcc -std=c11 -O2 -c bmp390-lib/src/third_party/bmp3.c -o bmp3.o
+//   g++ -std=c++17 -O2 -Ibmp390-lib/include -Ibmp390-lib/src -Ihdc3022-lib/include
+//       -Imultisensor/include benchmarks/bus_scheduling_benchmark.cpp
+//       benchmarks/virtual_devices.cpp multisensor/src/bus_scheduler.cpp
+//       hdc3022-lib/src/hdc3022_driver.cpp bmp390-lib/src/bmp390_driver.cpp
+//       bmp390-lib/src/compensation.cpp bmp390-lib/src/time_sync.cpp bmp3.o
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "bmp390/bmp390_driver.hpp"
+#include "hdc3022/hdc3022_driver.hpp"
+#include "multisensor/bus_scheduler.hpp"
+#include "multisensor/sensor.hpp"
+#include "virtual_devices.hpp"
+
+using multisensor::ISensor;
+
+using Clock = std::chrono::steady_clock;
+
+// -----------------------------------------------------------------------------
+// Adaptateurs ISensor sur capteurs simulés (sélection du périphérique avant
+// chaque appel au driver)
+// -----------------------------------------------------------------------------
+
+class SimBmp390Sensor : public ISensor
+{
+public:
+    SimBmp390Sensor(sim::VirtualBus& bus, uint32_t seed)
+        : bus_(bus),
+          device_(/*spi=*/false, seed),
+          bmp_(0x76, sim::VirtualBus::interface(), /*use_i2c=*/true)
+    {
+        bus_.select(device_);
+        ok_ = bmp_.init() == 0;
+
+        bmp390::Config cfg{};
+        cfg.pressure_oversampling    = bmp390::Config::Oversampling::X4;
+        cfg.temperature_oversampling = bmp390::Config::Oversampling::X1;
+        cfg.iir_filter               = bmp390::Config::IirFilterCoeff::Off;
+        cfg.power_mode               = bmp390::Config::PowerMode::Forced;
+        ok_ = ok_ && bmp_.configure(cfg) == 0;
+    }
+
+    void update() override
+    {
+        const uint32_t wait_us = trigger();
+        sim::sleep_until_ns(sim::now_ns() + static_cast<int64_t>(wait_us) * 1000);
+        collect();
+    }
+
+    uint32_t trigger() override
+    {
+        bus_.select(device_);
+        pending_ = bmp_.trigger_measurement() == 0;
+        return pending_ ? bmp_.conversion_time_us() : 0;
+    }
+
+    void collect() override
+    {
+        // Sans conversion lancée, les registres contiennent la mesure précédente
+        valid_ = false;
+        if (!pending_)
+        {
+            return;
+        }
+        pending_ = false;
+
+        bus_.select(device_);
+        valid_ = bmp_.read_measurement(last_) == 0;
+    }
+
+    double getTemperatureC() const override { return valid_ ? last_.temperature_c : std::nan(""); }
+
+    void log(std::ostream& os) const override { os << "[BMP390 sim] P=" << last_.pressure_pa << " Pa\n"; }
+
+    bool initialized() const { return ok_; }
+    const sim::VirtualBmp390& device() const { return device_; }
+
+private:
+    sim::VirtualBus&    bus_;
+    sim::VirtualBmp390  device_;
+    bmp390::Bmp390      bmp_;
+    bmp390::Measurement last_{};
+    bool                ok_      = false;
+    bool                pending_ = false;
+    bool                valid_   = false;
+};
+
+class SimHdc3022Sensor : public ISensor
+{
+public:
+    SimHdc3022Sensor(sim::VirtualBus& bus, uint32_t seed)
+        : bus_(bus),
+          device_(seed),
+          hdc_(0x44, sim::VirtualBus::interface())
+    {
+        bus_.select(device_);
+        ok_ = hdc_.init() == 0;
+        ok_ = ok_ && hdc_.configure(hdc3022::Config{}) == 0;
+    }
+
+    void update() override
+    {
+        bus_.select(device_);
+        valid_ = hdc_.measure(last_) == 0;
+    }
+
+    uint32_t trigger() override
+    {
+        bus_.select(device_);
+        pending_ = hdc_.trigger_measurement() == 0;
+        return pending_ ? hdc_.conversion_time_us() : 0;
+    }
+
+    void collect() override
+    {
+        valid_ = false;
+        if (!pending_)
+        {
+            return;
+        }
+        pending_ = false;
+
+        bus_.select(device_);
+        valid_ = hdc_.read_measurement(last_) == 0;
+    }
+
+    double getTemperatureC() const override { return valid_ ? last_.temperature_c : std::nan(""); }
+
+    void log(std::ostream& os) const override { os << "[HDC3022 sim] RH=" << last_.humidity_rh << " %\n"; }
+
+    bool initialized() const { return ok_; }
+    const sim::VirtualHdc3022& device() const { return device_; }
+
+private:
+    sim::VirtualBus&     bus_;
+    sim::VirtualHdc3022  device_;
+    hdc3022::Hdc3022     hdc_;
+    hdc3022::Measurement last_{};
+    bool                 ok_      = false;
+    bool                 pending_ = false;
+    bool                 valid_   = false;
+};
+
+// -----------------------------------------------------------------------------
+// Mesure
+// -----------------------------------------------------------------------------
+
+struct RunResult
+{
+    double   cycle_p50_us = 0.0;
+    double   cycle_max_us = 0.0;
+    double   bus_util     = 0.0;   // Occupation du bus / durée totale (virtuelle)
+    double   cpu_ns_cycle = 0.0;   // Temps hôte par cycle
+    uint64_t invalid      = 0;     // Lectures sans température valide
+};
+
+static int64_t sim_now_us()
+{
+    return sim::now_ns() / 1000;
+}
+
+static void sim_sleep_until_us(int64_t deadline_us)
+{
+    sim::sleep_until_ns(deadline_us * 1000);
+}
+
+template <typename CycleFn>
+static RunResult run(sim::VirtualBus& bus, const std::vector<ISensor*>& sensors, int cycles, CycleFn cycle)
+{
+    std::vector<int64_t> durations;
+    durations.reserve(static_cast<std::size_t>(cycles));
+
+    bus.reset_stats();
+    const int64_t v_start = sim::now_ns();
+    uint64_t invalid = 0;
+
+    const auto t0 = Clock::now();
+    for (int c = 0; c < cycles; ++c)
+    {
+        const int64_t begin = sim::now_ns();
+        cycle();
+        durations.push_back(sim::now_ns() - begin);
+
+        for (const ISensor* s : sensors)
+        {
+            invalid += std::isnan(s->getTemperatureC()) ? 1 : 0;
+        }
+    }
+    const auto t1 = Clock::now();
+
+    std::sort(durations.begin(), durations.end());
+
+    RunResult r{};
+    r.cycle_p50_us = static_cast<double>(durations[durations.size() / 2]) / 1000.0;
+    r.cycle_max_us = static_cast<double>(durations.back()) / 1000.0;
+    r.bus_util     = static_cast<double>(bus.busy_ns()) / static_cast<double>(sim::now_ns() - v_start);
+    r.cpu_ns_cycle = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+                     static_cast<double>(cycles);
+    r.invalid      = invalid;
+    return r;
+}
+
+static void print_result(const char* label, const RunResult& r)
+{
+    std::printf("%-12s cycle p50=%9.1f us  max=%9.1f us  (%7.1f Hz)  bus=%5.1f %%  cpu=%8.0f ns/cycle  invalides=%llu\n",
+                label, r.cycle_p50_us, r.cycle_max_us, 1e6 / r.cycle_p50_us, 100.0 * r.bus_util, r.cpu_ns_cycle,
+                static_cast<unsigned long long>(r.invalid));
+}
+
+int main(int argc, char** argv)
+{
+    const int bmp_count = argc > 1 ? std::atoi(argv[1]) : 4;
+    const int hdc_count = argc > 2 ? std::atoi(argv[2]) : 2;
+    const int cycles    = std::max(1, argc > 3 ? std::atoi(argv[3]) : 200);
+    const int i2c_khz   = argc > 4 ? std::atoi(argv[4]) : 400;
+
+    sim::BusTiming timing{};
+    timing.kind     = sim::BusTiming::Kind::I2c;
+    timing.clock_hz = static_cast<uint32_t>(i2c_khz) * 1000U;
+    sim::VirtualBus bus(timing);
+
+    std::vector<std::unique_ptr<SimBmp390Sensor>>  bmps;
+    std::vector<std::unique_ptr<SimHdc3022Sensor>> hdcs;
+    std::vector<ISensor*> sensors;
+
+    for (int i = 0; i < bmp_count; ++i)
+    {
+        bmps.push_back(std::make_unique<SimBmp390Sensor>(bus, static_cast<uint32_t>(i)));
+        if (!bmps.back()->initialized())
+        {
+            std::printf("Erreur init BMP390 simulé %d\n", i);
+            return 1;
+        }
+        sensors.push_back(bmps.back().get());
+    }
+    for (int i = 0; i < hdc_count; ++i)
+    {
+        hdcs.push_back(std::make_unique<SimHdc3022Sensor>(bus, static_cast<uint32_t>(i)));
+        if (!hdcs.back()->initialized())
+        {
+            std::printf("Erreur init HDC3022 simulé %d\n", i);
+            return 1;
+        }
+        sensors.push_back(hdcs.back().get());
+    }
+
+    std::printf("bmp390=%d hdc3022=%d cycles=%d i2c=%d kHz\n", bmp_count, hdc_count, cycles, i2c_khz);
+
+    // 1) Boucle série (mainLoop actuel)
+    const RunResult serial = run(bus, sensors, cycles, [&]() {
+        for (ISensor* s : sensors)
+        {
+            s->update();
+        }
+    });
+    print_result("série", serial);
+
+    // 2) Scheduler en deux phases, sur le temps virtuel
+    multisensor::SchedulerClock clock{};
+    clock.now_us         = sim_now_us;
+    clock.sleep_until_us = sim_sleep_until_us;
+
+    multisensor::BusScheduler scheduler(clock);
+    for (ISensor* s : sensors)
+    {
+        scheduler.add(*s);
+    }
+
+    const RunResult pipelined = run(bus, sensors, cycles, [&]() { scheduler.runCycle(); });
+    print_result("pipeline", pipelined);
+
+    std::printf("%-12s x%.2f\n", "accélération", serial.cycle_p50_us / pipelined.cycle_p50_us);
+
+    // Contrôle : aucune donnée lue avant la fin de conversion
+    uint64_t stale = 0;
+    uint64_t nacks = 0;
+    for (const auto& b : bmps)
+    {
+        stale += b->device().stale_reads();
+    }
+    for (const auto& h : hdcs)
+    {
+        nacks += h->device().nacks();
+    }
+    std::printf("%-12s lectures périmées BMP390=%llu, NACK HDC3022=%llu\n", "contrôle",
+                static_cast<unsigned long long>(stale), static_cast<unsigned long long>(nacks));
+
+    return 0;
+}
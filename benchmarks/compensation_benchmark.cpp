@@ -0,0 +1,143 @@
+// Benchmark de la compensation différée (compensation.hpp)
+// -------------------------------------------------------------
+// Mesure le coût de bmp390::compensate() sur des lots d’échantillons bruts,
+// puis vérifie (code de retour 1 en cas d’échec) que la compensation
+// différée est identique au bit près à Bmp390::read_measurement() : un
+// BMP390 simulé (virtual_devices.hpp) en mode forced est lu par read_raw()
+// puis par read_measurement() sur le même échantillon, pour 64 capteurs
+// de valeurs brutes différentes.
+//
+// Usage : compensation_benchmark [echantillons=1000000]
+// Compilation (exemple, depuis la racine du dépôt ; bmp3.c est compilé en C à part) :
+//   gcc -std=c11 -O2 -c bmp390-lib/src/third_party/bmp3.c -o bmp3.o
+//   g++ -std=c++17 -O2 -Ibmp390-lib/include -Ibmp390-lib/src -Ihdc3022-lib/include
+//       benchmarks/compensation_benchmark.cpp benchmarks/virtual_devices.cpp
+//       hdc3022-lib/src/hdc3022_driver.cpp bmp390-lib/src/bmp390_driver.cpp
+//       bmp390-lib/src/compensation.cpp bmp390-lib/src/time_sync.cpp bmp3.o
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "bmp390/bmp390_driver.hpp"
+#include "bmp390/compensation.hpp"
+#include "virtual_devices.hpp"
+
+using namespace bmp390;
+
+using Clock = std::chrono::steady_clock;
+
+static void run(std::size_t samples)
+{
+    const Calibration calib = make_calibration(sim::VirtualBmp390::kNvm.data());
+
+    // Valeurs brutes autour de 101325 Pa / 21,5 °C
+    std::mt19937_64                         rng(1);
+    std::uniform_int_distribution<uint32_t> press(5000000, 5400000);
+    std::uniform_int_distribution<uint32_t> temp(8200000, 8500000);
+
+    std::vector<RawMeasurement> raw(samples);
+    for (RawMeasurement& r : raw)
+    {
+        r.pressure    = press(rng);
+        r.temperature = temp(rng);
+    }
+    std::vector<Measurement> out(samples);
+
+    const auto t0 = Clock::now();
+    compensate(raw.data(), raw.size(), calib, out.data());
+    const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    // Empêche l’élimination du calcul
+    double sum = 0.0;
+    for (const Measurement& m : out)
+    {
+        sum += m.pressure_pa;
+    }
+
+    std::printf("compensate  %7.2f ns/échantillon  %8.1f M échantillons/s  (moyenne %.1f Pa)\n",
+                seconds * 1e9 / static_cast<double>(samples), static_cast<double>(samples) / seconds / 1e6,
+                sum / static_cast<double>(samples));
+}
+
+// -----------------------------------------------------------------------------
+// Contrôles
+// -----------------------------------------------------------------------------
+
+static bool check(bool ok, const char* what)
+{
+    std::printf("contrôle    %-58s %s\n", what, ok ? "ok" : "ÉCHEC");
+    return ok;
+}
+
+static bool check_deferred_matches_driver()
+{
+    const char* what = "compensate(read_raw) identique à read_measurement";
+
+    sim::reset_clock();
+    sim::VirtualBus bus({sim::BusTiming::Kind::I2c, 400000, 0});
+
+    Config cfg{};
+    cfg.pressure_oversampling    = Config::Oversampling::X1;
+    cfg.temperature_oversampling = Config::Oversampling::X1;
+    cfg.power_mode               = Config::PowerMode::Forced;
+
+    std::size_t compared   = 0;
+    std::size_t mismatches = 0;
+    for (uint32_t seed = 0; seed < 64; ++seed)
+    {
+        sim::VirtualBmp390 sensor(/*spi=*/false, seed);
+        Bmp390             driver(0x76, sim::VirtualBus::interface(), /*use_i2c=*/true);
+
+        bus.select(sensor);
+        if (driver.init() != 0 || driver.configure(cfg) != 0 || !driver.calibration())
+        {
+            return check(false, what);
+        }
+        const Calibration& calib = *driver.calibration();
+
+        // 32 conversions : les valeurs brutes du modèle varient d’un échantillon à l’autre
+        for (int i = 0; i < 32; ++i)
+        {
+            if (driver.trigger_measurement() != 0)
+            {
+                return check(false, what);
+            }
+            sim::sleep_until_ns(sim::now_ns() + static_cast<int64_t>(driver.conversion_time_us()) * 1000);
+
+            RawMeasurement raw{};
+            Measurement    direct{};
+            if (driver.read_raw(raw) != 0 || driver.read_measurement(direct) != 0)
+            {
+                return check(false, what);
+            }
+
+            Measurement deferred{};
+            compensate(&raw, 1, calib, &deferred);
+
+            ++compared;
+            if (deferred.pressure_pa != direct.pressure_pa || deferred.temperature_c != direct.temperature_c)
+            {
+                ++mismatches;
+            }
+        }
+    }
+
+    std::printf("%-12s %zu échantillons comparés, %zu écarts\n", "contrôle", compared, mismatches);
+    return check(mismatches == 0, what);
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t samples = static_cast<std::size_t>(std::max(1000, argc > 1 ? std::atoi(argv[1]) : 1000000));
+
+    run(samples);
+
+    bool ok = true;
+    ok = check_deferred_matches_driver() && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+// Benchmark de la chaîne de filtrage logiciel (filters.hpp)
+// -------------------------------------------------------------
+// Mesure le coût par échantillon de la chaîne décrite dans la doc
+// (MedianDespike, Biquad, Decimator, AltitudeKalman) selon le nombre de
+// capteurs, puis vérifie quelques cas limites (code de retour 1 en cas
+// d’échec) :
+//  - NaN en tête de flux (capteur qui démarre en retard, cf. TimeAligner) :
+//    MedianDespike doit s’amorcer sur les premiers échantillons valides
+//    sans propager de NaN,
+//  - échelon de pression : MedianDespike écarte le premier échantillon du
+//    palier puis suit le nouveau niveau,
+//  - Decimator en aval d’AltitudeKalman : l’altitude reste alignée sur la
+//    pression et la température décimées.
+//
+// Usage : filter_pipeline_benchmark [instants_par_lot=256] [lots=400]
+// Compilation (exemple, depuis la racine du dépôt) :
+//   g++ -std=c++17 -O3 -fno-trapping-math -Ibmp390-lib/include
+//       benchmarks/filter_pipeline_benchmark.cpp bmp390-lib/src/filters.cpp bmp390-lib/src/time_sync.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bmp390/filters.hpp"
+
+using namespace bmp390;
+
+using Clock = std::chrono::steady_clock;
+
+static const double kNan = std::numeric_limits<double>::quiet_NaN();
+
+static void build_pipeline(FilterPipeline& pipeline)
+{
+    pipeline.add(std::make_unique<MedianDespike>(Field::Pressure, /*threshold=*/50.0));
+    pipeline.add(std::make_unique<Biquad>(Field::Pressure, BiquadCoeffs::lowpass(200.0, 5.0)));
+    pipeline.add(std::make_unique<Decimator>(4));
+    pipeline.add(std::make_unique<AltitudeKalman>(/*q=*/0.01, /*r=*/1.0));
+}
+
+// Lot simulé : 200 Hz, pression autour de 101325 Pa, bruit 1 Pa
+static void fill(SampleBlock& block, std::size_t channels, std::size_t frames, std::size_t first, std::mt19937_64& rng)
+{
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    block.resize(channels, frames);
+    for (std::size_t f = 0; f < frames; ++f)
+    {
+        block.timestamp_ns[f] = static_cast<int64_t>(first + f) * 5000000LL;
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            block.pressure_pa[f * channels + c]   = 101325.0 - 12.0 * static_cast<double>(c) + noise(rng);
+            block.temperature_c[f * channels + c] = 21.5;
+        }
+    }
+}
+
+static void run(std::size_t channels, std::size_t frames, std::size_t blocks)
+{
+    FilterPipeline pipeline;
+    build_pipeline(pipeline);
+
+    std::mt19937_64 rng(channels);
+    std::vector<SampleBlock> input(8);
+    for (std::size_t i = 0; i < input.size(); ++i)
+    {
+        fill(input[i], channels, frames, i * frames, rng);
+    }
+
+    SampleBlock block;
+    double      seconds = 0.0;
+    for (std::size_t i = 0; i < blocks; ++i)
+    {
+        block = input[i % input.size()];   // Copie hors mesure
+
+        const auto t0 = Clock::now();
+        pipeline.process(block);
+        seconds += std::chrono::duration<double>(Clock::now() - t0).count();
+    }
+
+    const double samples = static_cast<double>(channels * frames * blocks);
+    std::printf("capteurs=%4zu  %7.2f ns/échantillon  %8.1f M échantillons/s\n", channels,
+                seconds * 1e9 / samples, samples / seconds / 1e6);
+}
+
+// -----------------------------------------------------------------------------
+// Contrôles
+// -----------------------------------------------------------------------------
+
+static bool check(bool ok, const char* what)
+{
+    std::printf("contrôle    %-58s %s\n", what, ok ? "ok" : "ÉCHEC");
+    return ok;
+}
+
+static bool check_leading_nan()
+{
+    // Capteur 0 : NaN au premier instant ; capteur 1 : NaN au deuxième ;
+    // capteur 2 : NaN sur tout le premier lot. Pic de +500 Pa à l’instant 6.
+    const std::size_t channels = 3;
+    const std::size_t frames   = 8;
+
+    MedianDespike despike(Field::Pressure, 50.0);
+
+    SampleBlock first;
+    first.resize(channels, frames);
+    for (std::size_t f = 0; f < frames; ++f)
+    {
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            first.pressure_pa[f * channels + c] = 101325.0 + static_cast<double>(f);
+        }
+    }
+    first.pressure_pa[0 * channels + 0] = kNan;
+    first.pressure_pa[1 * channels + 1] = kNan;
+    for (std::size_t f = 0; f < frames; ++f)
+    {
+        first.pressure_pa[f * channels + 2] = kNan;
+    }
+    first.pressure_pa[6 * channels + 0] += 500.0;
+    despike.process(first);
+
+    bool ok = std::isnan(first.pressure_pa[0]) && std::isnan(first.pressure_pa[1 * channels + 1]);
+    for (std::size_t f = 2; f < frames; ++f)
+    {
+        ok = ok && std::isfinite(first.pressure_pa[f * channels + 0]) &&
+             std::isfinite(first.pressure_pa[f * channels + 1]);
+    }
+    ok = ok && first.pressure_pa[6 * channels + 0] < 101400.0;
+
+    // Lot suivant : plus aucun NaN en entrée, aucun en sortie
+    SampleBlock second;
+    second.resize(channels, frames);
+    for (std::size_t i = 0; i < channels * frames; ++i)
+    {
+        second.pressure_pa[i] = 101330.0;
+    }
+    despike.process(second);
+    for (double v : second.pressure_pa)
+    {
+        ok = ok && std::isfinite(v);
+    }
+
+    return check(ok, "MedianDespike : NaN en tête de flux non propagés");
+}
+
+static bool check_step_response()
+{
+    // 4 échantillons à 100000 Pa puis 8 à 100200 Pa (seuil 50 Pa) : seul le
+    // premier échantillon du palier est traité comme un pic.
+    const std::size_t frames = 12;
+
+    MedianDespike despike(Field::Pressure, 50.0);
+
+    SampleBlock block;
+    block.resize(1, frames);
+    for (std::size_t f = 0; f < frames; ++f)
+    {
+        block.pressure_pa[f] = f < 4 ? 100000.0 : 100200.0;
+    }
+    despike.process(block);
+
+    bool ok = true;
+    for (std::size_t f = 0; f < frames; ++f)
+    {
+        ok = ok && block.pressure_pa[f] == (f < 5 ? 100000.0 : 100200.0);
+    }
+
+    return check(ok, "MedianDespike : échelon suivi après un échantillon");
+}
+
+static bool check_decimated_altitude()
+{
+    // Altitude fournie en amont égale à la pression : après décimation (groupes
+    // à cheval sur deux lots), les deux colonnes doivent rester identiques.
+    const std::size_t channels = 2;
+    const std::size_t frames   = 10;
+
+    Decimator decimator(4);
+    bool      ok    = true;
+    double    value = 0.0;
+    for (int i = 0; i < 2; ++i)
+    {
+        SampleBlock block;
+        block.resize(channels, frames);
+        for (std::size_t f = 0; f < frames; ++f)
+        {
+            for (std::size_t c = 0; c < channels; ++c)
+            {
+                block.pressure_pa[f * channels + c] = value + static_cast<double>(c);
+                block.altitude_m[f * channels + c]  = value + static_cast<double>(c);
+            }
+            value += 1.0;
+        }
+        decimator.process(block);
+
+        ok = ok && block.altitude_m.size() == block.frames * channels;
+        for (std::size_t j = 0; j < block.frames * channels; ++j)
+        {
+            ok = ok && block.altitude_m[j] == block.pressure_pa[j];
+        }
+    }
+
+    return check(ok, "Decimator : altitude alignée sur la pression décimée");
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t frames = static_cast<std::size_t>(std::max(4, argc > 1 ? std::atoi(argv[1]) : 256));
+    const std::size_t blocks = static_cast<std::size_t>(std::max(1, argc > 2 ? std::atoi(argv[2]) : 400));
+
+    std::printf("chaîne : MedianDespike -> Biquad -> Decimator(4) -> AltitudeKalman, %zu instants/lot\n", frames);
+    for (std::size_t channels : {1, 4, 16, 64, 256})
+    {
+        run(channels, frames, std::max<std::size_t>(1, blocks * 16 / channels));
+    }
+
+    bool ok = true;
+    ok = check_leading_nan() && ok;
+    ok = check_step_response() && ok;
+    ok = check_decimated_altitude() && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,439 @@
+// Benchmark de montée en charge : 1 à 1024 BMP390 virtuels
+// -------------------------------------------------------------
+// Répartit N capteurs simulés (virtual_devices.hpp) sur plusieurs bus
+// virtuels, un thread par bus, pour chaque modèle de bus (I2C 100 kHz,
+// 400 kHz, 1 MHz, SPI 10 MHz) et N = 1, 2, 4, ... jusqu'au maximum demandé.
+//
+// Les chemins réels du wrapper sont exécutés : Bmp390::init(), configure()
+// (mode normal, 200 Hz, X1/X1) puis read_measurement() en boucle, une
+// lecture par capteur et par période ODR (5 ms) tant que le bus le permet.
+//
+// Une ligne par configuration, au format CSV (défaut) ou JSON lines :
+//  - samples_per_s        : débit obtenu (temps virtuel) ; target_per_s = N · 200,
+//  - cpu_ns_per_sample    : temps CPU hôte des threads de bus par échantillon
+//                           (driver + modèle simulé),
+//  - bus_util             : occupation moyenne des bus (0 à 1),
+//  - allocs               : allocations pendant la phase de mesure,
+//  - read_cpu_p*_ns       : latence hôte d'un appel read_measurement(),
+//  - age_p*_us            : âge de la donnée à la fin de sa lecture (virtuel),
+//                           percentiles calculés sur au plus kMaxSamples lectures
+//                           tirées uniformément (réservoir), tous bus confondus,
+//  - missed               : échantillons écrasés avant lecture pendant la mesure
+//                           (bus saturé), y compris avant la première lecture.
+//
+// Usage : sensor_scaling_benchmark [max_capteurs=1024] [bus=4] [durée_ms=1000] [csv|json]
+// Compilation (exemple, depuis la racine du dépôt ; bmp3.c est compilé en C à part) :
+//   gcc -std=c11 -O2 -c bmp390-lib/src/third_party/bmp3.c -o bmp3.o
+//   g++ -std=c++17 -O2 -pthread -Ibmp390-lib/include -Ibmp390-lib/src -Ihdc3022-lib/include
+//       benchmarks/sensor_scaling_benchmark.cpp benchmarks/virtual_devices.cpp
+//       hdc3022-lib/src/hdc3022_driver.cpp bmp390-lib/src/bmp390_driver.cpp
+//       bmp390-lib/src/compensation.cpp bmp390-lib/src/time_sync.cpp bmp3.o
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <time.h>
+
+#include "bmp390/bmp390_driver.hpp"
+#include "virtual_devices.hpp"
+
+using namespace bmp390;
+
+using Clock = std::chrono::steady_clock;
+
+// -----------------------------------------------------------------------------
+// Comptage des allocations (par thread)
+// -----------------------------------------------------------------------------
+
+static thread_local uint64_t t_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++t_allocations;
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// -----------------------------------------------------------------------------
+// Configuration
+// -----------------------------------------------------------------------------
+
+struct BusModel
+{
+    const char*    name;
+    sim::BusTiming timing;
+};
+
+static const BusModel kBusModels[] = {
+    {"i2c_100k", {sim::BusTiming::Kind::I2c, 100000, 0}},
+    {"i2c_400k", {sim::BusTiming::Kind::I2c, 400000, 0}},
+    {"i2c_1m",   {sim::BusTiming::Kind::I2c, 1000000, 0}},
+    {"spi_10m",  {sim::BusTiming::Kind::Spi, 10000000, 0}},
+};
+
+// Bornes des arguments
+static constexpr long kMaxSensors    = 65536;
+static constexpr long kMaxBuses      = 256;
+static constexpr long kMaxDurationMs = 3600000;
+
+// Latences conservées pour les percentiles, réparties entre les bus : la
+// mémoire reste bornée (16 Mo) quelles que soient la durée et la taille.
+static constexpr std::size_t kMaxSamples = 1000000;
+
+// ODR 200 Hz : période de lecture de chaque capteur
+static constexpr int64_t kPeriodNs = 5000000;
+static constexpr double  kOdrHz    = 200.0;
+
+static int64_t thread_cpu_ns()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// -----------------------------------------------------------------------------
+// Un bus : init/configure puis lectures périodiques, sur son propre thread
+// -----------------------------------------------------------------------------
+
+struct BusResult
+{
+    uint64_t samples  = 0;
+    uint64_t errors   = 0;
+    uint64_t missed   = 0;
+    uint64_t allocs   = 0;
+    int64_t  elapsed_ns  = 0;   // Durée virtuelle de la phase de mesure
+    int64_t  busy_ns     = 0;
+    int64_t  cpu_ns      = 0;
+    int64_t  init_ns     = 0;   // Durée virtuelle de init() + configure()
+
+    std::vector<int64_t> read_cpu_ns;
+    std::vector<int64_t> age_ns;
+};
+
+static void run_bus(const BusModel& model, uint32_t first_seed, uint32_t devices, int64_t duration_ns,
+                    std::size_t max_samples, BusResult& out)
+{
+    const bool spi = model.timing.kind == sim::BusTiming::Kind::Spi;
+
+    sim::reset_clock();
+    sim::VirtualBus bus(model.timing);
+
+    Config cfg{};
+    cfg.pressure_oversampling    = Config::Oversampling::X1;
+    cfg.temperature_oversampling = Config::Oversampling::X1;
+    cfg.odr                      = Config::OutputDataRate::Hz200;
+    cfg.iir_filter               = Config::IirFilterCoeff::Off;
+
+    std::vector<std::unique_ptr<sim::VirtualBmp390>> sensors;
+    std::vector<std::unique_ptr<Bmp390>>             drivers;
+    sensors.reserve(devices);
+    drivers.reserve(devices);
+
+    for (uint32_t i = 0; i < devices; ++i)
+    {
+        sensors.push_back(std::make_unique<sim::VirtualBmp390>(spi, first_seed + i));
+        drivers.push_back(std::make_unique<Bmp390>(0x76, sim::VirtualBus::interface(), /*use_i2c=*/!spi));
+
+        bus.select(*sensors.back());
+        if (drivers.back()->init() != 0 || drivers.back()->configure(cfg) != 0)
+        {
+            ++out.errors;
+        }
+    }
+    out.init_ns = sim::now_ns();
+
+    // Premier échantillon disponible une période après le dernier configure()
+    sim::sleep_until_ns(out.init_ns + kPeriodNs);
+
+    // Pas d'allocation en mesure : capacités réservées pour le pire cas, dans
+    // la limite de max_samples (au-delà, échantillonnage par réservoir)
+    const std::size_t rounds   = static_cast<std::size_t>(duration_ns / kPeriodNs) + 2;
+    const std::size_t capacity = std::min(rounds * devices, max_samples);
+    out.read_cpu_ns.reserve(capacity);
+    out.age_ns.reserve(capacity);
+    std::minstd_rand rng(first_seed + 1);
+
+    bus.reset_stats();
+    for (const auto& sensor : sensors)
+    {
+        sensor->reset_stats();
+    }
+    const uint64_t allocs0 = t_allocations;
+    const int64_t  cpu0    = thread_cpu_ns();
+    const int64_t  start   = sim::now_ns();
+    int64_t        next    = start;
+
+    Measurement m{};
+    while (sim::now_ns() - start < duration_ns)
+    {
+        for (uint32_t i = 0; i < devices; ++i)
+        {
+            bus.select(*sensors[i]);
+
+            const auto t0  = Clock::now();
+            const int  ret = drivers[i]->read_measurement(m);
+            const auto t1  = Clock::now();
+
+            if (ret != 0)
+            {
+                ++out.errors;
+                continue;
+            }
+
+            ++out.samples;
+            const int64_t read_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+            const int64_t age_ns  = sim::now_ns() - sensors[i]->sample_time_ns();
+            if (out.read_cpu_ns.size() < capacity)
+            {
+                out.read_cpu_ns.push_back(read_ns);
+                out.age_ns.push_back(age_ns);
+                continue;
+            }
+
+            // Réservoir plein : la lecture n° k remplace une entrée avec la probabilité capacity / k
+            const uint64_t slot = std::uniform_int_distribution<uint64_t>(0, out.samples - 1)(rng);
+            if (slot < capacity)
+            {
+                out.read_cpu_ns[slot] = read_ns;
+                out.age_ns[slot]      = age_ns;
+            }
+        }
+
+        // Tour suivant à la prochaine période, ou immédiatement si le bus est saturé
+        next += kPeriodNs;
+        sim::sleep_until_ns(next);
+    }
+
+    out.elapsed_ns = sim::now_ns() - start;
+    out.cpu_ns     = thread_cpu_ns() - cpu0;
+    out.allocs     = t_allocations - allocs0;
+    out.busy_ns    = bus.busy_ns();
+
+    for (const auto& s : sensors)
+    {
+        out.missed += s->missed_samples();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Agrégation et sortie
+// -----------------------------------------------------------------------------
+
+static int64_t percentile(const std::vector<int64_t>& sorted, double q)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    return sorted[static_cast<std::size_t>(q * static_cast<double>(sorted.size() - 1))];
+}
+
+struct Row
+{
+    const BusModel* model = nullptr;
+    uint32_t buses   = 0;
+    uint32_t sensors = 0;
+    uint64_t samples = 0;
+    uint64_t errors  = 0;
+    uint64_t missed  = 0;
+    uint64_t allocs  = 0;
+    double   virtual_s         = 0.0;
+    double   samples_per_s     = 0.0;
+    double   cpu_ns_per_sample = 0.0;
+    double   bus_util          = 0.0;
+    double   init_ms           = 0.0;
+    int64_t  read_p50 = 0, read_p99 = 0, read_p999 = 0, read_max = 0;
+    int64_t  age_p50  = 0, age_p99  = 0, age_max   = 0;
+};
+
+static Row run_config(const BusModel& model, uint32_t sensors, uint32_t max_buses, int64_t duration_ns)
+{
+    const uint32_t    buses   = std::min(sensors, max_buses);
+    const std::size_t per_bus = std::max<std::size_t>(1, kMaxSamples / buses);
+
+    std::vector<BusResult>   results(buses);
+    std::vector<std::thread> threads;
+    uint32_t first = 0;
+    for (uint32_t b = 0; b < buses; ++b)
+    {
+        // Répartition équilibrée : les premiers bus prennent le reste
+        const uint32_t count = sensors / buses + (b < sensors % buses ? 1 : 0);
+        threads.emplace_back(run_bus, std::cref(model), first, count, duration_ns, per_bus, std::ref(results[b]));
+        first += count;
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    Row row{};
+    row.model   = &model;
+    row.buses   = buses;
+    row.sensors = sensors;
+
+    std::vector<int64_t> read_ns;
+    std::vector<int64_t> age_ns;
+    int64_t elapsed = 0;
+    int64_t cpu     = 0;
+    double  util    = 0.0;
+    int64_t init    = 0;
+    for (const BusResult& r : results)
+    {
+        row.samples += r.samples;
+        row.errors  += r.errors;
+        row.missed  += r.missed;
+        row.allocs  += r.allocs;
+        elapsed      = std::max(elapsed, r.elapsed_ns);
+        init         = std::max(init, r.init_ns);
+        cpu         += r.cpu_ns;
+        util        += r.elapsed_ns > 0 ? static_cast<double>(r.busy_ns) / static_cast<double>(r.elapsed_ns) : 0.0;
+        read_ns.insert(read_ns.end(), r.read_cpu_ns.begin(), r.read_cpu_ns.end());
+        age_ns.insert(age_ns.end(), r.age_ns.begin(), r.age_ns.end());
+    }
+    std::sort(read_ns.begin(), read_ns.end());
+    std::sort(age_ns.begin(), age_ns.end());
+
+    row.virtual_s         = static_cast<double>(elapsed) / 1e9;
+    row.samples_per_s     = row.virtual_s > 0.0 ? static_cast<double>(row.samples) / row.virtual_s : 0.0;
+    row.cpu_ns_per_sample = row.samples > 0 ? static_cast<double>(cpu) / static_cast<double>(row.samples) : 0.0;
+    row.bus_util          = util / static_cast<double>(buses);
+    row.init_ms           = static_cast<double>(init) / 1e6;
+    row.read_p50  = percentile(read_ns, 0.50);
+    row.read_p99  = percentile(read_ns, 0.99);
+    row.read_p999 = percentile(read_ns, 0.999);
+    row.read_max  = read_ns.empty() ? 0 : read_ns.back();
+    row.age_p50   = percentile(age_ns, 0.50);
+    row.age_p99   = percentile(age_ns, 0.99);
+    row.age_max   = age_ns.empty() ? 0 : age_ns.back();
+    return row;
+}
+
+static void print_csv_header()
+{
+    std::printf("bus,clock_hz,buses,sensors,samples,errors,missed,virtual_s,samples_per_s,target_per_s,"
+                "cpu_ns_per_sample,bus_util,allocs,allocs_per_sample,read_cpu_p50_ns,read_cpu_p99_ns,"
+                "read_cpu_p999_ns,read_cpu_max_ns,age_p50_us,age_p99_us,age_max_us,init_virtual_ms\n");
+}
+
+static void print_row(const Row& r, bool json)
+{
+    const double allocs_per_sample = r.samples > 0 ? static_cast<double>(r.allocs) / static_cast<double>(r.samples) : 0.0;
+    const char*  fmt = json
+        ? "{\"bus\":\"%s\",\"clock_hz\":%u,\"buses\":%u,\"sensors\":%u,\"samples\":%llu,\"errors\":%llu,"
+          "\"missed\":%llu,\"virtual_s\":%.3f,\"samples_per_s\":%.1f,\"target_per_s\":%.1f,"
+          "\"cpu_ns_per_sample\":%.1f,\"bus_util\":%.4f,\"allocs\":%llu,\"allocs_per_sample\":%.4f,"
+          "\"read_cpu_p50_ns\":%lld,\"read_cpu_p99_ns\":%lld,\"read_cpu_p999_ns\":%lld,\"read_cpu_max_ns\":%lld,"
+          "\"age_p50_us\":%.1f,\"age_p99_us\":%.1f,\"age_max_us\":%.1f,\"init_virtual_ms\":%.3f}\n"
+        : "%s,%u,%u,%u,%llu,%llu,%llu,%.3f,%.1f,%.1f,%.1f,%.4f,%llu,%.4f,%lld,%lld,%lld,%lld,%.1f,%.1f,%.1f,%.3f\n";
+
+    std::printf(fmt, r.model->name, r.model->timing.clock_hz, r.buses, r.sensors,
+                static_cast<unsigned long long>(r.samples), static_cast<unsigned long long>(r.errors),
+                static_cast<unsigned long long>(r.missed), r.virtual_s, r.samples_per_s,
+                kOdrHz * static_cast<double>(r.sensors), r.cpu_ns_per_sample, r.bus_util,
+                static_cast<unsigned long long>(r.allocs), allocs_per_sample,
+                static_cast<long long>(r.read_p50), static_cast<long long>(r.read_p99),
+                static_cast<long long>(r.read_p999), static_cast<long long>(r.read_max),
+                static_cast<double>(r.age_p50) / 1e3, static_cast<double>(r.age_p99) / 1e3,
+                static_cast<double>(r.age_max) / 1e3, r.init_ms);
+    std::fflush(stdout);
+}
+
+static void usage(const char* program)
+{
+    std::fprintf(stderr,
+                 "Usage : %s [max_capteurs=1024] [bus=4] [durée_ms=1000] [csv|json]\n"
+                 "  max_capteurs  1 à %ld (puissances de deux jusqu'à cette valeur)\n"
+                 "  bus           1 à %ld bus virtuels (un thread par bus)\n"
+                 "  durée_ms      1 à %ld ms de temps virtuel par configuration\n",
+                 program, kMaxSensors, kMaxBuses, kMaxDurationMs);
+}
+
+// Entier décimal dans [1, max], sans caractère parasite
+static bool parse_count(const char* arg, long max, long& out)
+{
+    char* end = nullptr;
+    errno = 0;
+    const long value = std::strtol(arg, &end, 10);
+    if (end == arg || *end != '\0' || errno != 0 || value < 1 || value > max)
+    {
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    long max_sensors = 1024;
+    long max_buses   = 4;
+    long duration_ms = 1000;
+    bool json        = false;
+
+    long* const counts[] = {&max_sensors, &max_buses, &duration_ms};
+    const long  limits[] = {kMaxSensors, kMaxBuses, kMaxDurationMs};
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0)
+        {
+            usage(argv[0]);
+            return 0;
+        }
+
+        bool ok = false;
+        if (i <= 3)
+        {
+            ok = parse_count(argv[i], limits[i - 1], *counts[i - 1]);
+        }
+        else if (i == 4)
+        {
+            json = std::strcmp(argv[i], "json") == 0;
+            ok   = json || std::strcmp(argv[i], "csv") == 0;
+        }
+
+        if (!ok)
+        {
+            std::fprintf(stderr, "Argument invalide : %s\n", argv[i]);
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    const int64_t duration_ns = duration_ms * 1000000LL;
+
+    if (!json)
+    {
+        print_csv_header();
+    }
+
+    for (const BusModel& model : kBusModels)
+    {
+        for (uint32_t sensors = 1; sensors <= static_cast<uint32_t>(max_sensors); sensors *= 2)
+        {
+            print_row(run_config(model, sensors, static_cast<uint32_t>(max_buses), duration_ns), json);
+        }
+    }
+
+    return 0;
+}
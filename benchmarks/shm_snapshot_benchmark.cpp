@@ -0,0 +1,268 @@
+// Benchmark du segment partagé ShmPublisher / ShmReader
+// -------------------------------------------------------------
+// Mesure :
+//  - la latence d'une lecture de snapshot côté lecteur (seqlock),
+//  - la latence de publication côté écrivain, sans puis avec lecteurs
+//    concurrents, pour vérifier que les lecteurs ne ralentissent jamais
+//    le thread d'acquisition.
+//
+// Puis vérifie (code de retour 1 en cas d’échec) le redémarrage de
+// l’écrivain : état Offline publié à l’arrêt, nouveau segment remappé par
+// ShmReader::open() et curseur de l’anneau ramené au début.
+//
+// Les lecteurs tournent ici dans des threads du même processus, mais via
+// leur propre mapping du segment (shm_open + mmap), comme un processus tiers.
+//
+// Usage : shm_snapshot_benchmark [capteurs=16] [lecteurs=2] [durée_ms=1000]
+// Compilation (exemple, depuis la racine du dépôt) :
+//   g++ -std=c++17 -O2 -pthread -Ibmp390-lib/include
+//       benchmarks/shm_snapshot_benchmark.cpp bmp390-lib/src/shm_snapshot.cpp -lrt
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "bmp390/shm_snapshot.hpp"
+
+using namespace bmp390;
+
+using Clock = std::chrono::steady_clock;
+
+static const char* kSegmentName = "/bmp390_shm_bench";
+
+// Nombre maximal de latences conservées par thread (pas d'allocation en mesure)
+static constexpr std::size_t kMaxSamples = 1000000;
+
+struct LatencyStats
+{
+    double p50_ns  = 0.0;
+    double p99_ns  = 0.0;
+    double p999_ns = 0.0;
+    double max_ns  = 0.0;
+    std::size_t count = 0;
+};
+
+static LatencyStats summarize(std::vector<int64_t>& samples)
+{
+    LatencyStats s{};
+    s.count = samples.size();
+    if (samples.empty())
+    {
+        return s;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) {
+        return static_cast<double>(samples[static_cast<std::size_t>(q * static_cast<double>(samples.size() - 1))]);
+    };
+    s.p50_ns  = at(0.50);
+    s.p99_ns  = at(0.99);
+    s.p999_ns = at(0.999);
+    s.max_ns  = static_cast<double>(samples.back());
+    return s;
+}
+
+static void print_stats(const char* label, const LatencyStats& s)
+{
+    std::printf("%-28s n=%-9zu p50=%8.0f ns  p99=%8.0f ns  p99.9=%8.0f ns  max=%9.0f ns\n",
+                label, s.count, s.p50_ns, s.p99_ns, s.p999_ns, s.max_ns);
+}
+
+// Publie en boucle tous les capteurs pendant `duration`, en mesurant chaque publish()
+static std::vector<int64_t> run_writer(ShmPublisher& pub, uint32_t sensors, std::chrono::milliseconds duration)
+{
+    std::vector<int64_t> lat;
+    lat.reserve(kMaxSamples);
+
+    Measurement m{};
+    m.pressure_pa   = 101325.0;
+    m.temperature_c = 21.5;
+
+    const auto end = Clock::now() + duration;
+    uint64_t i = 0;
+    while (Clock::now() < end)
+    {
+        for (uint32_t s = 0; s < sensors; ++s, ++i)
+        {
+            m.pressure_pa  += 0.01;
+            m.timestamp_ns  = static_cast<int64_t>(i);
+
+            const auto t0 = Clock::now();
+            pub.publish(s, m, SensorStatus::Ok);
+            const auto t1 = Clock::now();
+
+            if (lat.size() < kMaxSamples)
+            {
+                lat.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            }
+        }
+    }
+    return lat;
+}
+
+// -----------------------------------------------------------------------------
+// Contrôles
+// -----------------------------------------------------------------------------
+
+static bool check(bool ok, const char* what)
+{
+    std::printf("contrôle    %-58s %s\n", what, ok ? "ok" : "ÉCHEC");
+    return ok;
+}
+
+static bool check_writer_restart()
+{
+    const char* name = "/bmp390_shm_bench_restart";
+
+    Measurement m{};
+    m.pressure_pa   = 101325.0;
+    m.temperature_c = 21.5;
+    m.timestamp_ns  = 1;
+
+    ShmReader               reader(name);
+    std::vector<RingSample> recent;
+    uint64_t                cursor = 0;
+    Snapshot                snap{};
+
+    bool     ok    = true;
+    uint64_t epoch = 0;
+    {
+        ShmPublisher first(name, 1, /*ring_capacity=*/16);
+        ok = first.open() == 0 && reader.open() == 0;
+        for (int i = 0; i < 10; ++i)
+        {
+            first.publish(0, m, SensorStatus::Ok);
+        }
+        reader.read_recent(recent, cursor);
+        ok    = ok && cursor == 10;
+        epoch = reader.epoch();
+    }
+
+    // Écrivain arrêté : le lecteur garde son mapping, dernière mesure en Offline
+    ok = ok && reader.read(0, snap) && snap.status == SensorStatus::Offline &&
+         snap.measurement.pressure_pa == 101325.0;
+
+    // Écrivain redémarré : 3 échantillons dans le nouveau segment
+    ShmPublisher second(name, 1, /*ring_capacity=*/16);
+    ok = ok && second.open() == 0;
+    m.pressure_pa = 100000.0;
+    for (int i = 0; i < 3; ++i)
+    {
+        second.publish(0, m, SensorStatus::Ok);
+    }
+
+    ok = ok && reader.open() == 0 && reader.epoch() != epoch;
+    ok = ok && reader.read(0, snap) && snap.status == SensorStatus::Ok && snap.measurement.pressure_pa == 100000.0;
+
+    recent.clear();
+    reader.read_recent(recent, cursor);
+    ok = ok && recent.size() == 3 && cursor == 3;
+
+    return check(ok, "ShmReader : redémarrage de l’écrivain suivi");
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t sensors  = static_cast<uint32_t>(std::max(1, argc > 1 ? std::atoi(argv[1]) : 16));
+    const int      readers  = std::max(0, argc > 2 ? std::atoi(argv[2]) : 2);
+    const auto     duration = std::chrono::milliseconds(std::max(1, argc > 3 ? std::atoi(argv[3]) : 1000));
+
+    ShmPublisher pub(kSegmentName, sensors, /*ring_capacity=*/4096);
+    int ret = pub.open();
+    if (ret != 0)
+    {
+        std::printf("Erreur ouverture segment: %d\n", ret);
+        return 1;
+    }
+
+    std::printf("capteurs=%u lecteurs=%d durée=%lld ms\n",
+                sensors, readers, static_cast<long long>(duration.count()));
+
+    // 1) Écrivain seul (référence)
+    std::vector<int64_t> alone = run_writer(pub, sensors, duration);
+    print_stats("publish (sans lecteur)", summarize(alone));
+
+    // 2) Écrivain + lecteurs concurrents
+    std::atomic<bool> stop{false};
+    std::vector<std::vector<int64_t>> reader_lat(static_cast<std::size_t>(readers));
+    std::vector<uint64_t> failed(static_cast<std::size_t>(readers), 0);
+    std::vector<uint64_t> ring_read(static_cast<std::size_t>(readers), 0);
+    std::vector<std::thread> threads;
+
+    for (int r = 0; r < readers; ++r)
+    {
+        threads.emplace_back([&, r]() {
+            ShmReader reader(kSegmentName);
+            if (reader.open() != 0)
+            {
+                return;
+            }
+
+            auto& lat = reader_lat[static_cast<std::size_t>(r)];
+            lat.reserve(kMaxSamples);
+
+            std::vector<RingSample> recent;
+            recent.reserve(4096);
+            uint64_t cursor = 0;
+
+            Snapshot snap{};
+            uint32_t s = 0;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const auto t0 = Clock::now();
+                const bool ok = reader.read(s, snap);
+                const auto t1 = Clock::now();
+
+                if (!ok)
+                {
+                    ++failed[static_cast<std::size_t>(r)];
+                }
+                if (lat.size() < kMaxSamples)
+                {
+                    lat.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+                }
+
+                s = (s + 1) % sensors;
+                if (s == 0)
+                {
+                    // Consommateur de l'anneau (ex. export)
+                    recent.clear();
+                    reader.read_recent(recent, cursor);
+                    ring_read[static_cast<std::size_t>(r)] += recent.size();
+                }
+            }
+        });
+    }
+
+    std::vector<int64_t> contended = run_writer(pub, sensors, duration);
+    stop.store(true);
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    print_stats("publish (avec lecteurs)", summarize(contended));
+
+    std::vector<int64_t> all_reads;
+    uint64_t total_failed = 0;
+    uint64_t total_ring   = 0;
+    for (int r = 0; r < readers; ++r)
+    {
+        all_reads.insert(all_reads.end(), reader_lat[static_cast<std::size_t>(r)].begin(),
+                         reader_lat[static_cast<std::size_t>(r)].end());
+        total_failed += failed[static_cast<std::size_t>(r)];
+        total_ring   += ring_read[static_cast<std::size_t>(r)];
+    }
+    print_stats("read snapshot", summarize(all_reads));
+    std::printf("%-28s %llu\n", "lectures abandonnées", static_cast<unsigned long long>(total_failed));
+    std::printf("%-28s %llu\n", "échantillons anneau lus", static_cast<unsigned long long>(total_ring));
+
+    bool ok = true;
+    ok = check_writer_restart() && ok;
+    return ok ? 0 : 1;
+}
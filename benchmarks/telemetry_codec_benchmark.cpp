@@ -0,0 +1,210 @@
+// Benchmark du codec de télémétrie TelemetryEncoder / decode_block
+// -------------------------------------------------------------
+// Mesure, pour chaque jeu de données :
+//  - le taux de compression, par rapport à la structure Measurement
+//    (24 octets), aux seuls doubles pression + température (16 octets)
+//    et au texte CSV équivalent,
+//  - le débit d'encodage et de décodage (échantillons/s),
+//  - l'erreur maximale de reconstruction (au plus un demi-pas de quantification).
+//
+// Jeux de données :
+//  - simulés : 25 Hz, pression/température lentes + bruit type BMP390,
+//    horodatage sur la grille ODR (SensorClock) puis avec gigue hôte ;
+//  - enregistrés (optionnel) : fichier CSV "timestamp_ns,pressure_pa,temperature_c".
+//
+// Usage : telemetry_codec_benchmark [échantillons=1000000] [fichier.csv]
+// Compilation (exemple, depuis la racine du dépôt) :
+//   g++ -std=c++17 -O2 -Ibmp390-lib/include
+//       benchmarks/telemetry_codec_benchmark.cpp bmp390-lib/src/telemetry_codec.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "bmp390/telemetry_codec.hpp"
+
+using namespace bmp390;
+
+using Clock = std::chrono::steady_clock;
+
+// Nombre de passes mesurées (la meilleure est retenue)
+static constexpr int kPasses = 5;
+
+static std::vector<Measurement> simulate(std::size_t count, int64_t jitter_ns, uint32_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> press_noise(0.0, 1.0);   // ≈ bruit BMP390 en X4 (Pa)
+    std::normal_distribution<double> temp_noise(0.0, 0.003);  // °C
+    std::uniform_int_distribution<int64_t> jitter(-jitter_ns, jitter_ns);
+
+    const int64_t period_ns = 40000000;  // 25 Hz
+
+    std::vector<Measurement> out(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const double t = static_cast<double>(i) / 25.0;
+        out[i].timestamp_ns  = 1700000000000000000LL + static_cast<int64_t>(i) * period_ns +
+                               (jitter_ns > 0 ? jitter(rng) : 0);
+        out[i].pressure_pa   = 101325.0 + 30.0 * std::sin(t / 600.0) + press_noise(rng);
+        out[i].temperature_c = 21.5 + 0.8 * std::sin(t / 1800.0) + temp_noise(rng);
+    }
+    return out;
+}
+
+static bool load_csv(const char* path, std::vector<Measurement>& out)
+{
+    FILE* f = std::fopen(path, "r");
+    if (!f)
+    {
+        return false;
+    }
+
+    char line[256];
+    while (std::fgets(line, sizeof(line), f))
+    {
+        Measurement m{};
+        long long   ts = 0;
+        if (std::sscanf(line, "%lld,%lf,%lf", &ts, &m.pressure_pa, &m.temperature_c) == 3)
+        {
+            m.timestamp_ns = ts;
+            out.push_back(m);
+        }
+    }
+    std::fclose(f);
+    return !out.empty();
+}
+
+static std::size_t csv_size(const std::vector<Measurement>& data)
+{
+    std::size_t total = 0;
+    char line[128];
+    for (const Measurement& m : data)
+    {
+        total += static_cast<std::size_t>(std::snprintf(line, sizeof(line), "%" PRId64 ",%.2f,%.3f\n",
+                                                        m.timestamp_ns, m.pressure_pa, m.temperature_c));
+    }
+    return total;
+}
+
+static double seconds_since(Clock::time_point t0)
+{
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+static void run(const char* label, const std::vector<Measurement>& data, const TelemetryConfig& config)
+{
+    std::vector<uint8_t> encoded;
+    encoded.reserve(data.size() * sizeof(Measurement));
+
+    // Encodage
+    double best_encode = 1e30;
+    for (int pass = 0; pass < kPasses; ++pass)
+    {
+        encoded.clear();
+        TelemetryEncoder encoder(config);
+        const auto t0 = Clock::now();
+        for (const Measurement& m : data)
+        {
+            encoder.push(m, encoded);
+        }
+        encoder.flush(encoded);
+        best_encode = std::min(best_encode, seconds_since(t0));
+    }
+
+    // Décodage
+    std::vector<Measurement> decoded;
+    decoded.reserve(data.size());
+    double best_decode = 1e30;
+    std::size_t blocks = 0;
+    for (int pass = 0; pass < kPasses; ++pass)
+    {
+        decoded.clear();
+        blocks = 0;
+        const auto t0 = Clock::now();
+        std::size_t offset = 0;
+        while (offset < encoded.size())
+        {
+            std::size_t consumed = 0;
+            if (decode_block(encoded.data() + offset, encoded.size() - offset, decoded, consumed) != 0)
+            {
+                std::printf("%s : erreur de décodage au bloc %zu\n", label, blocks);
+                return;
+            }
+            offset += consumed;
+            ++blocks;
+        }
+        best_decode = std::min(best_decode, seconds_since(t0));
+    }
+
+    // Erreur de reconstruction
+    double      err_p   = 0.0;
+    double      err_t   = 0.0;
+    int64_t     err_ts  = 0;
+    std::size_t nan_bad = 0;   // NaN perdus ou apparus
+    for (std::size_t i = 0; i < data.size() && i < decoded.size(); ++i)
+    {
+        nan_bad += std::isnan(decoded[i].pressure_pa) != std::isnan(data[i].pressure_pa) ? 1 : 0;
+        nan_bad += std::isnan(decoded[i].temperature_c) != std::isnan(data[i].temperature_c) ? 1 : 0;
+        if (!std::isnan(data[i].pressure_pa))
+        {
+            err_p = std::max(err_p, std::fabs(decoded[i].pressure_pa - data[i].pressure_pa));
+        }
+        if (!std::isnan(data[i].temperature_c))
+        {
+            err_t = std::max(err_t, std::fabs(decoded[i].temperature_c - data[i].temperature_c));
+        }
+        err_ts = std::max<int64_t>(err_ts, std::llabs(decoded[i].timestamp_ns - data[i].timestamp_ns));
+    }
+
+    // Accès aléatoire : index des blocs à partir des seuls en-têtes
+    std::vector<std::size_t> offsets;
+    const auto t_index = Clock::now();
+    index_blocks(encoded.data(), encoded.size(), offsets);
+    const double index_s = seconds_since(t_index);
+
+    const double n     = static_cast<double>(data.size());
+    const double bytes = static_cast<double>(encoded.size());
+
+    std::printf("%s\n", label);
+    std::printf("  échantillons       %zu (%zu blocs, index en %.1f us)\n", data.size(), blocks, index_s * 1e6);
+    std::printf("  taille codée       %.0f octets (%.3f octets/échantillon)\n", bytes, bytes / n);
+    std::printf("  ratio              x%.1f vs Measurement (24 o), x%.1f vs 2 doubles (16 o), x%.1f vs CSV\n",
+                n * sizeof(Measurement) / bytes, n * 16.0 / bytes, static_cast<double>(csv_size(data)) / bytes);
+    std::printf("  encodage           %.1f M échantillons/s\n", n / best_encode / 1e6);
+    std::printf("  décodage           %.1f M échantillons/s\n", n / best_decode / 1e6);
+    std::printf("  erreur max         P=%.4f Pa  T=%.5f °C  t=%lld ns  (NaN incohérents : %zu)\n", err_p, err_t,
+                static_cast<long long>(err_ts), nan_bad);
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? static_cast<std::size_t>(std::atoll(argv[1])) : 1000000;
+
+    TelemetryConfig config{};   // 0,01 Pa, 0,001 °C, 1 µs, blocs de 256
+
+    std::printf("résolutions : P=%u décimales, T=%u décimales, t=%u ns ; %u échantillons/bloc\n\n",
+                config.pressure_decimals, config.temperature_decimals, config.timestamp_quantum_ns,
+                config.block_samples);
+
+    run("simulé, grille ODR", simulate(count, 0, 1), config);
+    run("simulé, gigue hôte ±50 us", simulate(count, 50000, 2), config);
+
+    if (argc > 2)
+    {
+        std::vector<Measurement> recorded;
+        if (!load_csv(argv[2], recorded))
+        {
+            std::printf("Impossible de lire %s\n", argv[2]);
+            return 1;
+        }
+        run(argv[2], recorded, config);
+    }
+
+    return 0;
+}
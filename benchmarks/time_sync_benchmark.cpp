@@ -0,0 +1,335 @@
+// Benchmark de la datation sur l’horloge capteur (time_sync.hpp)
+// -------------------------------------------------------------
+// Mesure le coût de SensorClock::observe() et de TimeAligner (push + pop)
+// selon le nombre de flux, puis vérifie (code de retour 1 en cas d’échec) :
+//  - le rebouclage du compteur SENSORTIME 24 bits,
+//  - l’estimation de la dérive d’un oscillateur à +150 ppm, avec une latence
+//    de lecture hôte aléatoire,
+//  - le rejet d’un point aberrant (préemption) puis le ré-ancrage après un
+//    saut d’horloge,
+//  - l’interpolation et la tolérance aux retardataires de TimeAligner,
+//  - Bmp390::read_fifo() sur un BMP390 simulé (virtual_devices.hpp).
+//
+// Usage : time_sync_benchmark [points=1000000]
+// Compilation (exemple, depuis la racine du dépôt ; bmp3.c est compilé en C à part) :
+//   gcc -std=c11 -O2 -c bmp390-lib/src/third_party/bmp3.c -o bmp3.o
+//   g++ -std=c++17 -O2 -Ibmp390-lib/include -Ibmp390-lib/src -Ihdc3022-lib/include
+//       benchmarks/time_sync_benchmark.cpp benchmarks/virtual_devices.cpp
+//       hdc3022-lib/src/hdc3022_driver.cpp bmp390-lib/src/bmp390_driver.cpp
+//       bmp390-lib/src/compensation.cpp bmp390-lib/src/time_sync.cpp bmp3.o
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "bmp390/bmp390_driver.hpp"
+#include "bmp390/time_sync.hpp"
+#include "virtual_devices.hpp"
+
+using namespace bmp390;
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr uint32_t kTickMask = 0x00FFFFFFU;
+
+// Capteur dont l’oscillateur dérive de `drift_ppm` ; instants hôte en ns.
+struct DriftingSensor
+{
+    double  tick_ns;
+    int64_t origin_ns;
+
+    uint32_t ticks_at(int64_t host_ns) const
+    {
+        const double ticks = std::floor(static_cast<double>(host_ns - origin_ns) / tick_ns);
+        return static_cast<uint32_t>(static_cast<uint64_t>(ticks) & kTickMask);
+    }
+};
+
+static DriftingSensor drifting_sensor(double drift_ppm, uint32_t first_tick)
+{
+    const double tick_ns = kSensorTimeTickNs * (1.0 + drift_ppm * 1e-6);
+    return {tick_ns, -static_cast<int64_t>(std::llround(first_tick * tick_ns))};
+}
+
+static void run_clock(std::size_t points)
+{
+    const DriftingSensor sensor = drifting_sensor(150.0, 0);
+
+    std::mt19937_64                        rng(1);
+    std::uniform_int_distribution<int64_t> latency(20000, 200000);
+
+    std::vector<uint32_t> ticks(points);
+    std::vector<int64_t>  host(points);
+    for (std::size_t i = 0; i < points; ++i)
+    {
+        const int64_t t = static_cast<int64_t>(i) * 5000000LL;
+        ticks[i]        = sensor.ticks_at(t);
+        host[i]         = t + latency(rng);
+    }
+
+    SensorClock clock;
+    const auto  t0 = Clock::now();
+    for (std::size_t i = 0; i < points; ++i)
+    {
+        clock.observe(ticks[i], host[i]);
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    std::printf("SensorClock::observe  %7.2f ns/point   dérive estimée %+.1f ppm\n",
+                seconds * 1e9 / static_cast<double>(points), clock.drift_ppm());
+}
+
+static void run_aligner(std::size_t streams, std::size_t points)
+{
+    TimeAligner  aligner(streams, 5000000, 20000000);
+    AlignedFrame frame;
+    std::size_t  frames = 0;
+
+    // Flux à 200 Hz décalés de 1 ms les uns des autres
+    const std::size_t steps = std::max<std::size_t>(1, points / streams);
+    const auto        t0    = Clock::now();
+    for (std::size_t i = 0; i < steps; ++i)
+    {
+        for (std::size_t s = 0; s < streams; ++s)
+        {
+            Measurement m{};
+            m.timestamp_ns  = static_cast<int64_t>(i + 1) * 5000000LL + static_cast<int64_t>(s % 5) * 1000000LL;
+            m.pressure_pa   = 101325.0;
+            m.temperature_c = 21.5;
+            aligner.push(s, m);
+        }
+        while (aligner.pop(frame))
+        {
+            ++frames;
+        }
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    std::printf("TimeAligner  flux=%4zu  %8.1f ns/trame  %7.2f ns/échantillon\n", streams,
+                seconds * 1e9 / static_cast<double>(std::max<std::size_t>(1, frames)),
+                seconds * 1e9 / static_cast<double>(steps * streams));
+}
+
+// -----------------------------------------------------------------------------
+// Contrôles
+// -----------------------------------------------------------------------------
+
+static bool check(bool ok, const char* what)
+{
+    std::printf("contrôle    %-58s %s\n", what, ok ? "ok" : "ÉCHEC");
+    return ok;
+}
+
+static bool check_wrap()
+{
+    // 128 ticks avant le rebouclage, puis 128 ticks après
+    SensorClock clock;
+    const int64_t host = 1000000000LL;
+    const int64_t step = static_cast<int64_t>(256 * kSensorTimeTickNs);
+
+    bool ok = clock.observe(0xFFFF80U, host);
+    ok = ok && clock.observe(0x000080U, host + step);
+    ok = ok && clock.locked() && std::fabs(clock.drift_ppm()) < 1e-6;
+
+    SensorClock unwrapper;
+    const uint64_t before = unwrapper.unwrap(0xFFFF80U);
+    const uint64_t after  = unwrapper.unwrap(0x000080U);
+    ok = ok && after - before == 256;
+    ok = ok && clock.to_host_ns(after) - clock.to_host_ns(before) == step;
+
+    return check(ok, "SensorClock : rebouclage du compteur 24 bits");
+}
+
+static bool check_drift()
+{
+    // Un point par seconde pendant 2 min ; le compteur reboucle après ~2,5 s.
+    // Latence hôte de 20 à 200 µs entre la lecture de SENSORTIME et la datation.
+    const DriftingSensor sensor = drifting_sensor(150.0, 0xFF0000U);
+
+    std::mt19937_64                        rng(2);
+    std::uniform_int_distribution<int64_t> latency(20000, 200000);
+
+    SensorClock clock;
+    int64_t     worst = 0;
+    for (int i = 0; i <= 120; ++i)
+    {
+        const int64_t  t     = static_cast<int64_t>(i) * 1000000000LL;
+        const uint32_t ticks = sensor.ticks_at(t);
+        clock.observe(ticks, t + latency(rng));
+
+        if (i >= 60)
+        {
+            // Instant hôte du tick courant, plus la latence moyenne
+            const double tick_start = std::floor(static_cast<double>(t - sensor.origin_ns) / sensor.tick_ns);
+            const int64_t expected  = sensor.origin_ns + static_cast<int64_t>(tick_start * sensor.tick_ns) + 110000;
+            const int64_t error     = clock.to_host_ns(clock.unwrap(ticks)) - expected;
+            worst = std::max(worst, std::abs(error));
+        }
+    }
+
+    const bool ok = std::fabs(clock.drift_ppm() - 150.0) < 5.0 && worst < 150000;
+    std::printf("%-12s dérive %+.2f ppm, erreur de datation max %.1f µs\n", "contrôle",
+                clock.drift_ppm(), static_cast<double>(worst) / 1e3);
+    return check(ok, "SensorClock : dérive +150 ppm estimée à 5 ppm près");
+}
+
+static bool check_outliers()
+{
+    // Estimateur verrouillé sur 20 points réguliers (100 ms, sans dérive)
+    SensorClock   clock;
+    const int64_t period = static_cast<int64_t>(2560 * kSensorTimeTickNs);
+    uint32_t      ticks  = 0;
+    int64_t       host   = 0;
+    for (int i = 0; i < 20; ++i)
+    {
+        clock.observe(ticks, host);
+        ticks += 2560;
+        host += period;
+    }
+    const double drift = clock.drift_ppm();
+
+    // Préemption de 5 ms : point écarté, modèle inchangé
+    bool ok = !clock.observe(ticks, host + 5000000);
+    ok = ok && clock.drift_ppm() == drift;
+    ok = ok && clock.observe(ticks, host);
+
+    // Saut de l’horloge hôte de 1 s : 7 rejets, puis le modèle repart du 8e point
+    int rejected = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        ticks += 2560;
+        host += period;
+        if (!clock.observe(ticks, host + 1000000000LL))
+        {
+            ++rejected;
+        }
+    }
+    ok = ok && rejected == 7;
+    ok = ok && clock.to_host_ns(clock.unwrap(ticks)) == host + 1000000000LL;
+
+    return check(ok, "SensorClock : rejet des aberrants, ré-ancrage après saut");
+}
+
+static bool check_aligner()
+{
+    // Deux flux à 200 Hz décalés (1 ms et 3,5 ms), pression en rampe de 1 Pa/ms :
+    // l’interpolation linéaire doit retrouver la rampe aux instants de la grille.
+    const auto ramp = [](int64_t t) { return 100000.0 + static_cast<double>(t) * 1e-6; };
+
+    TimeAligner  aligner(2, 10000000, 20000000);
+    AlignedFrame frame;
+    bool         ok     = true;
+    int          frames = 0;
+    for (int i = 0; i < 40; ++i)
+    {
+        for (std::size_t s = 0; s < 2; ++s)
+        {
+            Measurement m{};
+            m.timestamp_ns  = static_cast<int64_t>(i) * 5000000LL + (s == 0 ? 1000000LL : 3500000LL);
+            m.pressure_pa   = ramp(m.timestamp_ns);
+            m.temperature_c = 21.5;
+            aligner.push(s, m);
+        }
+        while (aligner.pop(frame))
+        {
+            ++frames;
+            ok = ok && frame.timestamp_ns % 10000000LL == 0 && frame.samples.size() == 2;
+            for (const Measurement& m : frame.samples)
+            {
+                ok = ok && std::fabs(m.pressure_pa - ramp(frame.timestamp_ns)) < 1e-6;
+            }
+        }
+    }
+    ok = ok && frames >= 18;
+
+    // Flux 1 interrompu : trames produites après max_latency_ns, flux 1 à NaN
+    int late = 0;
+    for (int i = 40; i < 50; ++i)
+    {
+        Measurement m{};
+        m.timestamp_ns  = static_cast<int64_t>(i) * 5000000LL + 1000000LL;
+        m.pressure_pa   = ramp(m.timestamp_ns);
+        m.temperature_c = 21.5;
+        aligner.push(0, m);
+        while (aligner.pop(frame))
+        {
+            late += std::isfinite(frame.samples[0].pressure_pa) && std::isnan(frame.samples[1].pressure_pa);
+        }
+    }
+    ok = ok && late > 0;
+
+    return check(ok, "TimeAligner : interpolation, flux en retard marqué NaN");
+}
+
+static bool check_read_fifo()
+{
+    sim::reset_clock();
+
+    sim::VirtualBus    bus({sim::BusTiming::Kind::I2c, 400000, 0});
+    sim::VirtualBmp390 sensor;
+    Bmp390             driver(0x76, sim::VirtualBus::interface(), /*use_i2c=*/true);
+
+    Config cfg{};
+    cfg.pressure_oversampling    = Config::Oversampling::X1;
+    cfg.temperature_oversampling = Config::Oversampling::X1;
+    cfg.odr                      = Config::OutputDataRate::Hz200;
+    cfg.fifo_enabled             = true;
+
+    bus.select(sensor);
+    if (driver.init() != 0 || driver.configure(cfg) != 0)
+    {
+        return check(false, "Bmp390::read_fifo : trames datées sur la grille ODR");
+    }
+    const int64_t start = sim::now_ns();
+
+    // 10 périodes : 10 trames espacées de 5 ms sur l’horloge capteur. Chaque
+    // lecture repart d’une horloge neuve (l’hôte réel et le temps simulé
+    // n’avancent pas au même rythme).
+    const auto collect = [&](int64_t deadline_ns, std::vector<Measurement>& out) {
+        SensorClock clock;
+        sim::sleep_until_ns(deadline_ns);
+        out.clear();
+        return driver.read_fifo(out, clock);
+    };
+
+    std::vector<Measurement> frames;
+    bool ok = collect(start + 52500000LL, frames) == 0 && frames.size() == 10;
+    for (std::size_t i = 0; ok && i < frames.size(); ++i)
+    {
+        ok = std::fabs(frames[i].pressure_pa - 101325.0) < 100.0 &&
+             (i == 0 || frames[i].timestamp_ns - frames[i - 1].timestamp_ns == 5000000LL);
+    }
+
+    // FIFO vidé par la lecture : 4 nouvelles trames, puis plus rien
+    ok = ok && collect(start + 72500000LL, frames) == 0 && frames.size() == 4;
+    ok = ok && collect(start + 72500000LL, frames) == 0 && frames.empty();
+
+    // Débordement : au plus 73 trames de 7 octets dans 512 octets
+    ok = ok && collect(start + 1000000000LL, frames) == 0 && frames.size() == 73;
+
+    return check(ok, "Bmp390::read_fifo : trames datées sur la grille ODR");
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t points = static_cast<std::size_t>(std::max(1000, argc > 1 ? std::atoi(argv[1]) : 1000000));
+
+    run_clock(points);
+    for (std::size_t streams : {2, 8, 32})
+    {
+        run_aligner(streams, points);
+    }
+
+    bool ok = true;
+    ok = check_wrap() && ok;
+    ok = check_drift() && ok;
+    ok = check_outliers() && ok;
+    ok = check_aligner() && ok;
+    ok = check_read_fifo() && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,526 @@
+#include "virtual_devices.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "hdc3022/hdc3022_driver.hpp"
+
+namespace sim
+{
+
+// Registres BMP390 utilisés par bmp3.c (cf. bmp3_defs.h)
+static constexpr uint8_t kRegChipId     = 0x00;
+static constexpr uint8_t kRegStatus     = 0x03;
+static constexpr uint8_t kRegData       = 0x04;
+static constexpr uint8_t kRegSensorTime = 0x0C;
+static constexpr uint8_t kRegFifoLength = 0x12;
+static constexpr uint8_t kRegFifoData   = 0x14;
+static constexpr uint8_t kRegFifoConfig = 0x17;
+static constexpr uint8_t kRegPwrCtrl    = 0x1B;
+static constexpr uint8_t kRegOsr        = 0x1C;
+static constexpr uint8_t kRegOdr        = 0x1D;
+static constexpr uint8_t kRegCalib      = 0x31;
+static constexpr uint8_t kRegCmd        = 0x7E;
+
+static constexpr uint8_t kBmp390ChipId  = 0x60;
+static constexpr uint8_t kStatusCmdRdy  = 0x10;
+static constexpr uint8_t kStatusDrdy    = 0x60;  // drdy_press | drdy_temp
+static constexpr uint8_t kSoftReset     = 0xB6;
+static constexpr uint8_t kFifoFlush     = 0xB0;
+static constexpr uint8_t kModeMask      = 0x30;
+static constexpr uint8_t kModeForced    = 0x10;
+static constexpr uint8_t kModeNormal    = 0x30;
+
+// FIFO_CONFIG_1 et en-têtes de trames FIFO
+static constexpr uint8_t  kFifoMode        = 0x01;
+static constexpr uint8_t  kFifoStopOnFull  = 0x02;
+static constexpr uint8_t  kFifoTimeEn      = 0x04;
+static constexpr uint8_t  kFifoPressTempEn = 0x18;
+static constexpr uint8_t  kFrameTempPress  = 0x94;
+static constexpr uint8_t  kFrameTime       = 0xA0;
+static constexpr uint8_t  kFrameEmpty      = 0x80;
+static constexpr uint16_t kFrameLen        = 7;
+
+// Échantillon brut ≈ 101325 Pa / 21,5 °C avec kNvm
+static constexpr uint32_t kRawPressure    = 5192700;
+static constexpr uint32_t kRawTemperature = 8332000;
+
+// Les conversions simulées durent 90 % du maximum du datasheet
+static constexpr int64_t kTypicalPercent = 90;
+
+static thread_local int64_t     t_now_ns = 0;
+static thread_local VirtualBus* t_bus    = nullptr;
+
+int64_t now_ns()
+{
+    return t_now_ns;
+}
+
+void sleep_until_ns(int64_t deadline_ns)
+{
+    t_now_ns = std::max(t_now_ns, deadline_ns);
+}
+
+void reset_clock()
+{
+    t_now_ns = 0;
+}
+
+// ============================================================================
+// VirtualBus implementation
+// ============================================================================
+
+// Callbacks BusInterface : dispatch vers le périphérique sélectionné du thread
+struct BusAccess
+{
+    static int8_t read(uint8_t reg, uint8_t* data, uint16_t len)
+    {
+        if (!t_bus || !t_bus->selected_)
+        {
+            return -1;
+        }
+        // Adresse + registre + adresse (restart) en I2C, octet de commande en SPI
+        t_bus->account(3, len);
+        return t_bus->selected_->read(reg, data, len);
+    }
+
+    static int8_t write(uint8_t reg, const uint8_t* data, uint16_t len)
+    {
+        if (!t_bus || !t_bus->selected_)
+        {
+            return -1;
+        }
+        t_bus->account(2, len);
+        return t_bus->selected_->write(reg, data, len);
+    }
+
+    static int8_t receive(uint8_t* data, uint16_t len)
+    {
+        if (!t_bus || !t_bus->selected_)
+        {
+            return -1;
+        }
+        t_bus->account(1, len);
+        return t_bus->selected_->receive(data, len);
+    }
+
+    static void delay_us(uint32_t period)
+    {
+        sleep_until_ns(t_now_ns + static_cast<int64_t>(period) * 1000);
+    }
+};
+
+VirtualBus::VirtualBus(const BusTiming& timing)
+    : timing_(timing)
+{
+}
+
+void VirtualBus::select(VirtualDevice& device)
+{
+    selected_ = &device;
+    t_bus     = this;
+}
+
+bmp390::BusInterface VirtualBus::interface()
+{
+    bmp390::BusInterface bus{};
+    bus.read     = BusAccess::read;
+    bus.write    = BusAccess::write;
+    bus.receive  = BusAccess::receive;
+    bus.delay_us = BusAccess::delay_us;
+    return bus;
+}
+
+void VirtualBus::reset_stats()
+{
+    busy_ns_   = 0;
+    transfers_ = 0;
+    bytes_     = 0;
+}
+
+void VirtualBus::account(uint32_t header_bytes, uint16_t len)
+{
+    // I2C : 9 bits par octet (ACK) + start/stop ; SPI : 8 bits par octet,
+    // un seul octet de commande
+    const uint64_t bits = timing_.kind == BusTiming::Kind::I2c
+                              ? 9ULL * (header_bytes + len) + 2
+                              : 8ULL * (1 + len);
+    const int64_t duration = static_cast<int64_t>(bits * 1000000000ULL / timing_.clock_hz);
+
+    busy_ns_   += duration;
+    transfers_ += 1;
+    bytes_     += len;
+
+    sleep_until_ns(t_now_ns + duration + timing_.overhead_ns);
+}
+
+// ============================================================================
+// VirtualBmp390 implementation
+// ============================================================================
+
+const std::array<uint8_t, 21> VirtualBmp390::kNvm = {
+    0x6B, 0x6C, 0xA4, 0x49, 0xF9, 0x3E, 0xF2, 0x7E, 0xF7, 0x23, 0x01,
+    0xD3, 0x5D, 0xDC, 0x74, 0x03, 0xFA, 0x9A, 0x46, 0x10, 0xC4,
+};
+
+VirtualBmp390::VirtualBmp390(bool spi, uint32_t seed)
+    : spi_(spi),
+      seed_(seed)
+{
+    reset_registers();
+}
+
+int8_t VirtualBmp390::read(uint8_t reg, uint8_t* data, uint16_t len)
+{
+    refresh();
+
+    // En SPI, bmp3.c positionne le bit de lecture et attend un octet factice
+    uint16_t offset = 0;
+    if (spi_)
+    {
+        reg &= 0x7F;
+        if (len > 0)
+        {
+            data[0] = 0xFF;
+            offset  = 1;
+        }
+    }
+
+    if (reg <= kRegData && kRegData < reg + len - offset && forced_pending_)
+    {
+        ++stale_reads_;
+    }
+
+    // Compteur SENSORTIME : 39,0625 µs par tick
+    const uint32_t ticks = static_cast<uint32_t>((now_ns() * 16) / 625000) & 0xFFFFFFU;
+    regs_[kRegSensorTime]     = static_cast<uint8_t>(ticks);
+    regs_[kRegSensorTime + 1] = static_cast<uint8_t>(ticks >> 8);
+    regs_[kRegSensorTime + 2] = static_cast<uint8_t>(ticks >> 16);
+
+    regs_[kRegFifoLength]     = static_cast<uint8_t>(fifo_len_);
+    regs_[kRegFifoLength + 1] = static_cast<uint8_t>(fifo_len_ >> 8);
+
+    if (reg == kRegFifoData)
+    {
+        pop_fifo(data + offset, static_cast<uint16_t>(len - offset));
+        return 0;
+    }
+
+    for (uint16_t i = offset; i < len; ++i)
+    {
+        const uint32_t addr = reg + i - offset;
+        data[i] = addr < regs_.size() ? regs_[addr] : 0;
+    }
+    return 0;
+}
+
+int8_t VirtualBmp390::write(uint8_t reg, const uint8_t* data, uint16_t len)
+{
+    refresh();
+
+    if (len == 0)
+    {
+        return -1;
+    }
+
+    // bmp3_set_regs : donnée, puis paires (adresse, donnée) entrelacées
+    apply(static_cast<uint8_t>(reg & 0x7F), data[0]);
+    for (uint16_t i = 1; i + 1 < len; i += 2)
+    {
+        apply(static_cast<uint8_t>(data[i] & 0x7F), data[i + 1]);
+    }
+    return 0;
+}
+
+void VirtualBmp390::reset_registers()
+{
+    regs_.fill(0);
+    regs_[kRegChipId] = kBmp390ChipId;
+    regs_[kRegStatus] = kStatusCmdRdy;
+    regs_[kRegOsr]    = 0x02;
+    std::copy(kNvm.begin(), kNvm.end(), regs_.begin() + kRegCalib);
+
+    forced_pending_ = false;
+    normal_latched_ = 0;
+    missed_base_    = 0;
+    fifo_len_       = 0;
+}
+
+void VirtualBmp390::reset_stats()
+{
+    refresh();
+
+    // L'échantillon courant, pas encore lu, peut encore être perdu
+    const uint64_t index = (regs_[kRegPwrCtrl] & kModeMask) == kModeNormal ? normal_index() : 0;
+    missed_base_    = index > 0 ? index - 1 : 0;
+    missed_samples_ = 0;
+    stale_reads_    = 0;
+}
+
+uint64_t VirtualBmp390::missed_samples() const
+{
+    if ((regs_[kRegPwrCtrl] & kModeMask) != kModeNormal)
+    {
+        return missed_samples_;
+    }
+
+    // Échantillons déjà écrasés depuis la dernière lecture (le plus récent reste lisible)
+    const uint64_t index = normal_index();
+    const uint64_t first = std::max(normal_latched_, missed_base_) + 1;
+    return missed_samples_ + (index > first ? index - first : 0);
+}
+
+uint64_t VirtualBmp390::normal_index() const
+{
+    // Période ODR : 5 ms · 2^odr_sel
+    const int64_t period = 5000000LL << (regs_[kRegOdr] & 0x1F);
+    return static_cast<uint64_t>((now_ns() - normal_start_ns_) / period);
+}
+
+void VirtualBmp390::apply(uint8_t reg, uint8_t value)
+{
+    if (reg >= regs_.size())
+    {
+        return;
+    }
+
+    if (reg == kRegCmd)
+    {
+        if (value == kSoftReset)
+        {
+            reset_registers();
+        }
+        else if (value == kFifoFlush)
+        {
+            fifo_len_ = 0;
+        }
+        return;
+    }
+
+    regs_[reg] = value;
+
+    if (reg == kRegPwrCtrl)
+    {
+        const uint8_t mode = value & kModeMask;
+        forced_pending_ = mode == kModeForced;
+        if (forced_pending_)
+        {
+            forced_end_ns_ = now_ns() + conversion_ns();
+        }
+        else if (mode == kModeNormal)
+        {
+            normal_start_ns_ = now_ns();
+            normal_latched_  = 0;
+            missed_base_     = 0;
+        }
+    }
+}
+
+void VirtualBmp390::refresh()
+{
+    if (forced_pending_ && now_ns() >= forced_end_ns_)
+    {
+        // Fin de conversion forced : retour automatique en veille
+        forced_pending_     = false;
+        regs_[kRegPwrCtrl] &= static_cast<uint8_t>(~kModeMask);
+        sample_time_ns_     = forced_end_ns_;
+        latch_sample();
+        push_fifo(1);
+        return;
+    }
+
+    if ((regs_[kRegPwrCtrl] & kModeMask) == kModeNormal)
+    {
+        const int64_t  period = 5000000LL << (regs_[kRegOdr] & 0x1F);
+        const uint64_t index  = normal_index();
+        if (index > normal_latched_)
+        {
+            // Échantillons terminés puis écrasés sans lecture, premier compris
+            const uint64_t first = std::max(normal_latched_, missed_base_) + 1;
+            const uint64_t count = index - normal_latched_;
+            missed_samples_ += index > first ? index - first : 0;
+            normal_latched_  = index;
+            sample_time_ns_  = normal_start_ns_ + static_cast<int64_t>(index) * period;
+            latch_sample();
+            push_fifo(count);
+        }
+    }
+}
+
+void VirtualBmp390::latch_sample()
+{
+    ++conversions_;
+
+    // Légère variation par capteur et par échantillon
+    const uint32_t press = kRawPressure + (seed_ % 64) * 100 + static_cast<uint32_t>(conversions_ % 32) * 4;
+    const uint32_t temp  = kRawTemperature + (seed_ % 16) * 200;
+
+    regs_[kRegData]     = static_cast<uint8_t>(press);
+    regs_[kRegData + 1] = static_cast<uint8_t>(press >> 8);
+    regs_[kRegData + 2] = static_cast<uint8_t>(press >> 16);
+    regs_[kRegData + 3] = static_cast<uint8_t>(temp);
+    regs_[kRegData + 4] = static_cast<uint8_t>(temp >> 8);
+    regs_[kRegData + 5] = static_cast<uint8_t>(temp >> 16);
+    regs_[kRegStatus]  |= kStatusDrdy;
+}
+
+void VirtualBmp390::push_fifo(uint64_t frames)
+{
+    const uint8_t config = regs_[kRegFifoConfig];
+    if (!(config & kFifoMode) || (config & kFifoPressTempEn) != kFifoPressTempEn)
+    {
+        return;
+    }
+
+    // Les échantillons intermédiaires reprennent les valeurs du dernier ; au-delà
+    // de la capacité, seules les trames les plus récentes comptent.
+    const uint64_t capacity = fifo_.size() / kFrameLen;
+    for (uint64_t i = 0; i < std::min(frames, capacity); ++i)
+    {
+        if (static_cast<std::size_t>(fifo_len_ + kFrameLen) > fifo_.size())
+        {
+            if (config & kFifoStopOnFull)
+            {
+                return;
+            }
+
+            // FIFO plein : la trame la plus ancienne est écrasée
+            std::memmove(fifo_.data(), fifo_.data() + kFrameLen, fifo_len_ - kFrameLen);
+            fifo_len_ = static_cast<uint16_t>(fifo_len_ - kFrameLen);
+        }
+
+        // En-tête, température puis pression (ordre inverse des registres de données)
+        uint8_t* frame = fifo_.data() + fifo_len_;
+        frame[0] = kFrameTempPress;
+        std::copy(regs_.begin() + kRegData + 3, regs_.begin() + kRegData + 6, frame + 1);
+        std::copy(regs_.begin() + kRegData, regs_.begin() + kRegData + 3, frame + 4);
+        fifo_len_ = static_cast<uint16_t>(fifo_len_ + kFrameLen);
+    }
+}
+
+void VirtualBmp390::pop_fifo(uint8_t* data, uint16_t len)
+{
+    const uint16_t count = std::min(len, fifo_len_);
+    std::copy(fifo_.begin(), fifo_.begin() + count, data);
+    std::memmove(fifo_.data(), fifo_.data() + count, fifo_len_ - count);
+    fifo_len_ = static_cast<uint16_t>(fifo_len_ - count);
+
+    // FIFO vidé : trame sensor_time (si activée), puis trames vides
+    uint16_t i = count;
+    if (fifo_len_ == 0 && (regs_[kRegFifoConfig] & kFifoTimeEn) && len - i >= 4)
+    {
+        data[i++] = kFrameTime;
+        data[i++] = regs_[kRegSensorTime];
+        data[i++] = regs_[kRegSensorTime + 1];
+        data[i++] = regs_[kRegSensorTime + 2];
+    }
+    std::fill(data + i, data + len, kFrameEmpty);
+}
+
+int64_t VirtualBmp390::conversion_ns() const
+{
+    // Même formule que Bmp390::conversion_time_us() (datasheet §3.9.2)
+    const uint8_t  pwr      = regs_[kRegPwrCtrl];
+    const uint32_t press_os = 1U << (regs_[kRegOsr] & 0x07);
+    const uint32_t temp_os  = 1U << ((regs_[kRegOsr] >> 3) & 0x07);
+
+    int64_t us = 234;
+    if (pwr & 0x01)
+    {
+        us += 392 + static_cast<int64_t>(press_os) * 2020;
+    }
+    if (pwr & 0x02)
+    {
+        us += 163 + static_cast<int64_t>(temp_os) * 2020;
+    }
+    return us * 1000 * kTypicalPercent / 100;
+}
+
+// ============================================================================
+// VirtualHdc3022 implementation
+// ============================================================================
+
+VirtualHdc3022::VirtualHdc3022(uint32_t seed)
+    : seed_(seed)
+{
+}
+
+int8_t VirtualHdc3022::read(uint8_t reg, uint8_t* data, uint16_t len)
+{
+    // Pas d'accès par registre sur le HDC3022
+    (void)reg;
+    (void)data;
+    (void)len;
+    return -1;
+}
+
+int8_t VirtualHdc3022::write(uint8_t reg, const uint8_t* data, uint16_t len)
+{
+    if (len != 1)
+    {
+        return -1;
+    }
+
+    const uint16_t command = static_cast<uint16_t>((static_cast<uint16_t>(reg) << 8) | data[0]);
+    int64_t        max_us  = 0;
+
+    switch (command)
+    {
+        case 0x2400: max_us = 12500; break;
+        case 0x240B: max_us = 7500;  break;
+        case 0x2416: max_us = 5000;  break;
+        case 0x24FF: max_us = 3700;  break;
+        case 0x30A2:
+            pending_   = false;
+            reply_len_ = 0;
+            return 0;
+        case 0x3781:
+            stage_word(0, 0x3000);
+            reply_len_ = 3;
+            return 0;
+        default:
+            return -1;
+    }
+
+    pending_   = true;
+    ready_ns_  = now_ns() + max_us * 1000 * kTypicalPercent / 100;
+    reply_len_ = 0;
+    return 0;
+}
+
+int8_t VirtualHdc3022::receive(uint8_t* data, uint16_t len)
+{
+    if (pending_)
+    {
+        if (now_ns() < ready_ns_)
+        {
+            ++nacks_;
+            return -1;
+        }
+
+        // ≈ 22 °C / 45 % RH, légère variation par capteur et par échantillon
+        ++conversions_;
+        pending_ = false;
+        stage_word(0, static_cast<uint16_t>(25096 + seed_ % 64));
+        stage_word(3, static_cast<uint16_t>(29491 + conversions_ % 16));
+        reply_len_ = 6;
+    }
+
+    if (len > reply_len_)
+    {
+        ++nacks_;
+        return -1;
+    }
+
+    std::memcpy(data, reply_.data(), len);
+    return 0;
+}
+
+void VirtualHdc3022::stage_word(std::size_t offset, uint16_t word)
+{
+    reply_[offset]     = static_cast<uint8_t>(word >> 8);
+    reply_[offset + 1] = static_cast<uint8_t>(word);
+    reply_[offset + 2] = hdc3022::crc8(&reply_[offset], 2);
+}
+
+}  // namespace sim
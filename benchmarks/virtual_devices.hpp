@@ -0,0 +1,211 @@
+// Capteurs et bus simulés pour les benchmarks
+// -------------------------------------------------------------
+// Le temps est virtuel (ns, propre à chaque thread) : un transfert avance
+// l'horloge de sa durée sur le bus modélisé, un delay_us() de sa période.
+// Les drivers réels (bmp390::Bmp390, hdc3022::Hdc3022) tournent sans
+// modification au-dessus de ces modèles via bmp390::BusInterface.
+//
+// BusInterface ne transporte pas de contexte : comme l'ioctl I2C_SLAVE sous
+// Linux, on sélectionne le périphérique cible (VirtualBus::select) avant
+// chaque appel au driver.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "bmp390/bmp390_driver.hpp"
+
+namespace sim
+{
+
+/// Instant virtuel courant (ns) du thread appelant.
+int64_t now_ns();
+
+/// Avance l'horloge virtuelle du thread jusqu'à `deadline_ns` (sans effet si passé).
+void sleep_until_ns(int64_t deadline_ns);
+
+/// Remet l'horloge virtuelle du thread à zéro.
+void reset_clock();
+
+/**
+ * @brief Modèle temporel d'un bus.
+ */
+struct BusTiming
+{
+    enum class Kind : uint8_t
+    {
+        I2c,
+        Spi
+    };
+
+    Kind     kind     = Kind::I2c;
+    uint32_t clock_hz = 400000;
+
+    /// Coût logiciel fixe par transfert (appel système, pilote), en ns.
+    int64_t  overhead_ns = 0;
+};
+
+/**
+ * @brief Périphérique simulé, adressé par les callbacks de BusInterface.
+ */
+class VirtualDevice
+{
+public:
+    virtual ~VirtualDevice() = default;
+
+    virtual int8_t read(uint8_t reg, uint8_t* data, uint16_t len) = 0;
+    virtual int8_t write(uint8_t reg, const uint8_t* data, uint16_t len) = 0;
+
+    /// Lecture sans registre (capteurs à commandes) ; refusée par défaut.
+    virtual int8_t receive(uint8_t* data, uint16_t len)
+    {
+        (void)data;
+        (void)len;
+        return -1;
+    }
+};
+
+/**
+ * @brief Bus simulé : comptabilise l'occupation et fait avancer le temps virtuel.
+ */
+class VirtualBus
+{
+public:
+    explicit VirtualBus(const BusTiming& timing);
+
+    /// Rend `device` cible des callbacks du thread courant.
+    void select(VirtualDevice& device);
+
+    /// Callbacks à passer aux drivers (communs à tous les bus).
+    static bmp390::BusInterface interface();
+
+    const BusTiming& timing() const { return timing_; }
+
+    /// Temps cumulé d'occupation du bus (ns).
+    int64_t busy_ns() const { return busy_ns_; }
+
+    /// Nombre de transferts et d'octets utiles échangés.
+    uint64_t transfers() const { return transfers_; }
+    uint64_t bytes() const { return bytes_; }
+
+    void reset_stats();
+
+private:
+    friend struct BusAccess;
+
+    /// Durée d'un transfert : `header_bytes` (adresse, registre) + `len` octets utiles.
+    void account(uint32_t header_bytes, uint16_t len);
+
+    BusTiming      timing_;
+    VirtualDevice* selected_  = nullptr;
+    int64_t        busy_ns_   = 0;
+    uint64_t       transfers_ = 0;
+    uint64_t       bytes_     = 0;
+};
+
+/**
+ * @brief BMP390 simulé : registres, calibration, conversions forced et normal.
+ *
+ * Interprète le protocole de bmp3.c (écritures entrelacées adresse/donnée,
+ * octet factice en lecture SPI). Une lecture des données pendant une
+ * conversion forced rend l'échantillon précédent et est comptée comme
+ * lecture périmée.
+ *
+ * FIFO : seules les trames pression + température sont modélisées ; une
+ * lecture au-delà des données rend la trame sensor_time puis des trames vides.
+ */
+class VirtualBmp390 : public VirtualDevice
+{
+public:
+    /// Calibration NVM d'un capteur réel (registres 0x31 à 0x45).
+    static const std::array<uint8_t, 21> kNvm;
+
+    explicit VirtualBmp390(bool spi = false, uint32_t seed = 0);
+
+    int8_t read(uint8_t reg, uint8_t* data, uint16_t len) override;
+    int8_t write(uint8_t reg, const uint8_t* data, uint16_t len) override;
+
+    /// Conversions terminées.
+    uint64_t conversions() const { return conversions_; }
+
+    /// Lectures des données pendant une conversion forced.
+    uint64_t stale_reads() const { return stale_reads_; }
+
+    /// Échantillons du mode normal écrasés avant d'avoir été lus à l'instant
+    /// courant, y compris avant la première lecture (depuis reset_stats() ou
+    /// le passage en mode normal).
+    uint64_t missed_samples() const;
+
+    /// Instant virtuel (ns) de fin de conversion de l'échantillon courant.
+    int64_t sample_time_ns() const { return sample_time_ns_; }
+
+    /// Remet à zéro lectures périmées et échantillons perdus ; les échantillons
+    /// terminés avant l'appel ne sont plus comptés (début d'une phase de mesure).
+    void reset_stats();
+
+private:
+    void     reset_registers();
+    void     apply(uint8_t reg, uint8_t value);
+    void     refresh();
+    void     latch_sample();
+    void     push_fifo(uint64_t frames);
+    void     pop_fifo(uint8_t* data, uint16_t len);
+    int64_t  conversion_ns() const;
+    uint64_t normal_index() const;
+
+    bool     spi_;
+    uint32_t seed_;
+
+    std::array<uint8_t, 128> regs_{};
+
+    /// FIFO matériel : 73 trames de 7 octets au plus.
+    std::array<uint8_t, 512> fifo_{};
+    uint16_t                 fifo_len_ = 0;
+
+    bool     forced_pending_  = false;
+    int64_t  forced_end_ns_   = 0;
+    int64_t  normal_start_ns_ = 0;
+    uint64_t normal_latched_  = 0;
+    uint64_t missed_base_     = 0;   // Dernier échantillon exclu du comptage des pertes
+
+    int64_t  sample_time_ns_ = 0;
+
+    uint64_t conversions_    = 0;
+    uint64_t stale_reads_    = 0;
+    uint64_t missed_samples_ = 0;
+};
+
+/**
+ * @brief HDC3022 simulé : commandes 16 bits, NACK pendant la conversion.
+ */
+class VirtualHdc3022 : public VirtualDevice
+{
+public:
+    explicit VirtualHdc3022(uint32_t seed = 0);
+
+    int8_t read(uint8_t reg, uint8_t* data, uint16_t len) override;
+    int8_t write(uint8_t reg, const uint8_t* data, uint16_t len) override;
+    int8_t receive(uint8_t* data, uint16_t len) override;
+
+    uint64_t conversions() const { return conversions_; }
+
+    /// Lectures refusées (conversion en cours).
+    uint64_t nacks() const { return nacks_; }
+
+private:
+    void stage_word(std::size_t offset, uint16_t word);
+
+    uint32_t seed_;
+
+    std::array<uint8_t, 6> reply_{};
+    uint16_t reply_len_ = 0;
+
+    bool    pending_    = false;
+    int64_t ready_ns_   = 0;
+
+    uint64_t conversions_ = 0;
+    uint64_t nacks_       = 0;
+};
+
+}  // namespace sim
@@ -1,17 +1,24 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 struct bmp3_dev;  // Forward declaration of Bosch BMP3 device struct
 
 namespace bmp390
 {
 
+class SensorClock;        // Voir bmp390/time_sync.hpp
+struct Calibration;       // Voir bmp390/compensation.hpp
+struct RawMeasurement;    // Voir bmp390/compensation.hpp
+
 /**
  * @brief Abstraction de l’interface bus (I2C ou SPI) pour le BMP390.
  *
  * Les fonctions doivent être fournies par l’application et réaliser
  * les accès registres (adressés par un registre 8 bits) et le délai.
+ * Partagée avec les autres drivers du dépôt (ex. hdc3022::Hdc3022).
  */
 struct BusInterface
 {
@@ -41,6 +48,18 @@ struct BusInterface
      * @param period Durée du délai en microsecondes.
      */
     void (*delay_us)(uint32_t period) = nullptr;
+
+    /**
+     * @brief Lecture sans adresse de registre (optionnelle).
+     *
+     * Nécessaire aux capteurs pilotés par commandes (HDC3022) dont le
+     * résultat se lit directement après la commande ; inutilisée par le BMP390.
+     *
+     * @param data Buffer de destination.
+     * @param len  Nombre d’octets à lire.
+     * @return 0 si succès, valeur négative en cas d’erreur.
+     */
+    int8_t (*receive)(uint8_t* data, uint16_t len) = nullptr;
 };
 
 /**
@@ -82,6 +101,13 @@ struct Config
         Hz0_01  = 14
     };
 
+    /// Mode de fonctionnement.
+    enum class PowerMode : uint8_t
+    {
+        Normal = 0,  ///< Conversions périodiques à l’ODR configuré.
+        Forced = 1   ///< Une conversion par appel à Bmp390::trigger_measurement().
+    };
+
     /// Coefficients de filtre IIR génériques.
     enum class IirFilterCoeff : uint8_t
     {
@@ -106,6 +132,12 @@ struct Config
 
     /// Coefficient de filtre IIR (par défaut faible).
     IirFilterCoeff iir_filter = IirFilterCoeff::Coeff3;
+
+    /// Active le FIFO (pression + température + trame sensor_time) pour read_fifo().
+    bool fifo_enabled = false;
+
+    /// Mode de fonctionnement (par défaut normal).
+    PowerMode power_mode = PowerMode::Normal;
 };
 
 /**
@@ -118,6 +150,9 @@ struct Measurement
 
     /// Température compensée en degrés Celsius.
     double temperature_c = 0.0;
+
+    /// Horodatage hôte monotone (ns, std::chrono::steady_clock), 0 si inconnu.
+    int64_t timestamp_ns = 0;
 };
 
 /**
@@ -157,7 +192,8 @@ public:
      * @brief Configure les paramètres de mesure du capteur.
      *
      * Cette méthode encapsule l’appel à bmp3_set_sensor_settings et
-     * bmp3_set_op_mode (typiquement en mode normal ou forced).
+     * bmp3_set_op_mode. En mode forced, le capteur reste en veille
+     * jusqu’au premier trigger_measurement().
      *
      * @param config Configuration souhaitée (oversampling, ODR, filtre).
      * @return 0 si succès, valeur négative en cas d’erreur.
@@ -175,11 +211,101 @@ public:
      */
     int read_measurement(Measurement& out);
 
+    /**
+     * @brief Lance une conversion unique (mode forced).
+     *
+     * Retourne dès la commande envoyée ; le résultat est lisible par
+     * read_measurement() ou read_raw() après conversion_time_us(). Le bus
+     * reste libre pendant la conversion.
+     *
+     * @return 0 si succès, BMP3_E_CONFIGURATION_ERR hors mode forced,
+     *         valeur négative en cas d’erreur.
+     */
+    int trigger_measurement();
+
+    /**
+     * @brief Durée maximale d’une conversion pour la configuration courante.
+     *
+     * Formule du datasheet (§3.9.2) : 234 µs + 392 µs + 2^osr_p · 2020 µs
+     * (pression) + 163 µs + 2^osr_t · 2020 µs (température).
+     *
+     * @return Durée en microsecondes.
+     */
+    uint32_t conversion_time_us() const;
+
+    /**
+     * @brief Lit une mesure horodatée à partir du compteur sensor_time.
+     *
+     * Les registres de données et SENSORTIME sont lus en une seule rafale
+     * (même instantané, compensation par bmp390::compensate()), le point
+     * (sensor_time, instant hôte) alimente l’estimateur de dérive de `clock`,
+     * puis `out.timestamp_ns` est reconstruit sur l’horloge hôte.
+     *
+     * La datation suppose la grille ODR du mode normal : en mode forced,
+     * utiliser read_measurement(Measurement&) (horodatage à la réception).
+     *
+     * @param out   Structure de sortie pour la mesure.
+     * @param clock Estimateur d’horloge propre à ce capteur.
+     * @return 0 si succès, BMP3_E_CONFIGURATION_ERR hors mode normal,
+     *         valeur négative en cas d’erreur.
+     */
+    int read_measurement(Measurement& out, SensorClock& clock);
+
+    /**
+     * @brief Lit le compteur 24 bits SENSORTIME du capteur.
+     *
+     * @param ticks Valeur brute du compteur (24 bits utiles).
+     * @return 0 si succès, valeur négative en cas d’erreur.
+     */
+    int read_sensor_time(uint32_t& ticks);
+
+    /**
+     * @brief Vide le FIFO et ajoute les trames lues à `out`.
+     *
+     * Nécessite `Config::fifo_enabled` et le mode normal. La trame sensor_time renvoyée en fin
+     * de lecture sert de point de synchronisation pour `clock` ; chaque trame
+     * est ensuite datée en remontant la grille ODR depuis ce point. Permet de
+     * lire par lots sans perdre la précision temporelle.
+     *
+     * @param out   Vecteur de sortie (les trames sont ajoutées en fin).
+     * @param clock Estimateur d’horloge propre à ce capteur.
+     * @return 0 si succès, valeur négative en cas d’erreur.
+     */
+    int read_fifo(std::vector<Measurement>& out, SensorClock& clock);
+
+    /**
+     * @brief Lit un échantillon brut 24 bits, sans compensation.
+     *
+     * Une seule lecture bus des registres de données : la compensation est
+     * différée (autre cœur, requête, retraitement d’archive) via
+     * bmp390::compensate() et la calibration de ce capteur.
+     *
+     * @param out Échantillon brut de sortie (horodaté à la réception).
+     * @return 0 si succès, valeur négative en cas d’erreur.
+     */
+    int read_raw(RawMeasurement& out);
+
+    /**
+     * @brief Calibration usine du capteur, lue pendant init().
+     *
+     * @return Calibration immuable partageable entre threads, nullptr avant init().
+     */
+    std::shared_ptr<const Calibration> calibration() const { return calibration_; }
+
+    /// Identifiant du device (adresse I2C ou chip select) à viser dans les callbacks du bus.
+    uint8_t dev_id() const { return dev_id_; }
+
 private:
     uint8_t dev_id_;
     bool use_i2c_;
     BusInterface bus_;
 
+    /// Dernière configuration appliquée (ODR nécessaire pour dater le FIFO).
+    Config config_;
+
+    /// Calibration lue à l’init, partagée avec les consommateurs des données brutes.
+    std::shared_ptr<const Calibration> calibration_;
+
     /// Pointeur vers la structure BMP3 interne (gérée en implémentation).
     bmp3_dev* dev_;
 };
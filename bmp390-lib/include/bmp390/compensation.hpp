@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "bmp390/bmp390_driver.hpp"
+
+namespace bmp390
+{
+
+/// Taille du bloc de calibration NVM du BMP390 (registres 0x31 à 0x45).
+constexpr std::size_t kCalibrationNvmSize = 21;
+
+/**
+ * @brief Calibration usine d’un capteur, immuable une fois lue.
+ *
+ * Contient les octets NVM bruts (à archiver avec les données brutes pour
+ * pouvoir les recompenser plus tard) et les coefficients quantifiés qui
+ * en découlent. Sans état mutable : partageable entre threads sans verrou.
+ */
+struct Calibration
+{
+    /// Octets NVM bruts, tels que lus sur le capteur.
+    std::array<uint8_t, kCalibrationNvmSize> nvm{};
+
+    /// Coefficients quantifiés (formules du driver Bosch, compensation flottante).
+    double par_t1 = 0.0, par_t2 = 0.0, par_t3 = 0.0;
+    double par_p1 = 0.0, par_p2 = 0.0, par_p3 = 0.0, par_p4  = 0.0;
+    double par_p5 = 0.0, par_p6 = 0.0, par_p7 = 0.0, par_p8  = 0.0;
+    double par_p9 = 0.0, par_p10 = 0.0, par_p11 = 0.0;
+};
+
+/**
+ * @brief Échantillon brut 24 bits, non compensé.
+ */
+struct RawMeasurement
+{
+    /// Pression brute (24 bits).
+    uint32_t pressure = 0;
+
+    /// Température brute (24 bits).
+    uint32_t temperature = 0;
+
+    /// Horodatage hôte monotone (ns), 0 si inconnu.
+    int64_t timestamp_ns = 0;
+};
+
+/**
+ * @brief Construit une calibration à partir des 21 octets NVM du capteur.
+ *
+ * @param nvm Octets lus à partir du registre BMP3_REG_CALIB_DATA.
+ */
+Calibration make_calibration(const uint8_t* nvm);
+
+/**
+ * @brief Compense un échantillon brut.
+ *
+ * Reproduit la compensation flottante de bmp3_get_sensor_data (y compris
+ * les bornes et les puissances en float) : un échantillon compensé en
+ * différé est identique à celui de Bmp390::read_measurement.
+ */
+Measurement compensate(const RawMeasurement& raw, const Calibration& calib);
+
+/**
+ * @brief Compense un lot d’échantillons bruts d’un même capteur.
+ *
+ * @param raw   Tableau de `count` échantillons bruts.
+ * @param count Nombre d’échantillons.
+ * @param calib Calibration du capteur d’origine.
+ * @param out   Tableau de sortie de `count` mesures.
+ */
+void compensate(const RawMeasurement* raw, std::size_t count, const Calibration& calib, Measurement* out);
+
+}  // namespace bmp390
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bmp390/bmp390_driver.hpp"
+
+namespace bmp390
+{
+
+struct AlignedFrame;  // Voir bmp390/time_sync.hpp
+
+/**
+ * @brief Lot de mesures multi-capteurs au format struct-of-arrays.
+ *
+ * Les valeurs sont rangées instant par instant, capteurs contigus :
+ * `pressure_pa[frame * channels + channel]`. Les étages de filtrage
+ * parcourent les capteurs en boucle interne, sans dépendance ni branchement,
+ * ce qui permet au compilateur de vectoriser sur l’ensemble des capteurs
+ * (`-O3 -fno-trapping-math` avec GCC ; `-ffast-math` est à proscrire car il
+ * casse la détection des NaN).
+ */
+struct SampleBlock
+{
+    /// Nombre de capteurs (colonnes).
+    std::size_t channels = 0;
+
+    /// Nombre d’instants (lignes).
+    std::size_t frames = 0;
+
+    /// Pression en Pascals, [frame * channels + channel].
+    std::vector<double> pressure_pa;
+
+    /// Température en degrés Celsius, [frame * channels + channel].
+    std::vector<double> temperature_c;
+
+    /// Altitude en mètres, remplie par AltitudeKalman, [frame * channels + channel].
+    std::vector<double> altitude_m;
+
+    /// Horodatage commun de chaque instant (ns hôte), [frame].
+    std::vector<int64_t> timestamp_ns;
+
+    /// Dimensionne le lot (les valeurs existantes ne sont pas conservées).
+    void resize(std::size_t channel_count, std::size_t frame_count);
+
+    /// Ajoute un instant issu de TimeAligner (le nombre de capteurs doit correspondre).
+    void append(const AlignedFrame& frame);
+
+    /// Écrit une mesure à la position (frame, channel).
+    void set(std::size_t frame, std::size_t channel, const Measurement& m);
+
+    /// Relit la mesure à la position (frame, channel).
+    Measurement get(std::size_t frame, std::size_t channel) const;
+};
+
+/// Grandeur traitée par un étage de filtrage.
+enum class Field : uint8_t
+{
+    Pressure,
+    Temperature,
+    Altitude
+};
+
+/**
+ * @brief Étage de filtrage logiciel appliqué en place sur un SampleBlock.
+ *
+ * L’état interne (un jeu de variables par capteur) est conservé d’un lot
+ * à l’autre ; il est réinitialisé si le nombre de capteurs change.
+ * Les échantillons NaN traversent l’étage sans modifier son état.
+ */
+class FilterStage
+{
+public:
+    virtual ~FilterStage() = default;
+
+    /// @brief Filtre le lot en place.
+    virtual void process(SampleBlock& block) = 0;
+
+    /// @brief Remet l’état interne à zéro.
+    virtual void reset() = 0;
+};
+
+/**
+ * @brief Décimation par moyenne glissante de `factor` instants.
+ *
+ * Réduit `block.frames` d’un facteur `factor` (les instants restants sont
+ * accumulés jusqu’au lot suivant). L’horodatage de sortie est le milieu du
+ * groupe moyenné. S’applique à la pression, à la température et à
+ * l’altitude (NaN si aucun AltitudeKalman ne la calcule en amont).
+ */
+class Decimator : public FilterStage
+{
+public:
+    explicit Decimator(std::size_t factor);
+
+    void process(SampleBlock& block) override;
+    void reset() override;
+
+private:
+    std::size_t factor_;
+    std::size_t pending_  = 0;
+    int64_t     first_ts_ = 0;
+    std::vector<double> acc_p_;
+    std::vector<double> acc_t_;
+    std::vector<double> acc_a_;
+    std::vector<double> count_p_;
+    std::vector<double> count_t_;
+    std::vector<double> count_a_;
+};
+
+/**
+ * @brief Coefficients d’une cellule biquad normalisée (a0 = 1).
+ */
+struct BiquadCoeffs
+{
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0;
+    double a1 = 0.0, a2 = 0.0;
+
+    /**
+     * @brief Passe-bas du second ordre (formules « Audio EQ Cookbook »).
+     *
+     * @param sample_rate_hz Fréquence d’échantillonnage du flux filtré.
+     * @param cutoff_hz      Fréquence de coupure à -3 dB.
+     * @param q              Facteur de qualité (0,7071 : Butterworth).
+     */
+    static BiquadCoeffs lowpass(double sample_rate_hz, double cutoff_hz, double q = 0.70710678118654752);
+};
+
+/**
+ * @brief Filtre IIR biquad (forme directe II transposée), un état par capteur.
+ *
+ * Remplace le filtre IIR matériel du BMP390 (`Config::IirFilterCoeff`) :
+ * le capteur peut tourner filtre désactivé pour une latence minimale.
+ */
+class Biquad : public FilterStage
+{
+public:
+    Biquad(Field field, const BiquadCoeffs& coeffs);
+
+    void process(SampleBlock& block) override;
+    void reset() override;
+
+private:
+    Field field_;
+    BiquadCoeffs c_;
+    std::vector<double> z1_;
+    std::vector<double> z2_;
+    std::vector<double> primed_;
+};
+
+/**
+ * @brief Suppression des pics par médiane causale sur 3 échantillons.
+ *
+ * Un échantillon est remplacé par la médiane (x[n-2], x[n-1], x[n]) s’il
+ * s’en écarte de plus de `threshold` ; les échantillons normaux passent
+ * inchangés, sans retard. Un échelon n’est écarté que sur son premier
+ * échantillon.
+ */
+class MedianDespike : public FilterStage
+{
+public:
+    MedianDespike(Field field, double threshold);
+
+    void process(SampleBlock& block) override;
+    void reset() override;
+
+private:
+    Field  field_;
+    double threshold_;
+    std::vector<double> history_;   // Échantillons valides vus par capteur (0 à 2)
+    std::vector<double> prev1_;
+    std::vector<double> prev2_;
+};
+
+/**
+ * @brief Filtre de Kalman scalaire sur l’altitude barométrique.
+ *
+ * Convertit la pression en altitude (formule barométrique internationale)
+ * puis l’estime avec un modèle marche aléatoire par capteur. Le résultat
+ * est écrit dans `block.altitude_m`.
+ */
+class AltitudeKalman : public FilterStage
+{
+public:
+    /**
+     * @param process_noise_m2     Variance du bruit de modèle par instant (m²).
+     * @param measurement_noise_m2 Variance du bruit de mesure (m²).
+     * @param sea_level_pa         Pression de référence au niveau de la mer.
+     */
+    AltitudeKalman(double process_noise_m2, double measurement_noise_m2, double sea_level_pa = 101325.0);
+
+    void process(SampleBlock& block) override;
+    void reset() override;
+
+private:
+    double q_;
+    double r_;
+    double sea_level_pa_;
+    std::vector<double> x_;
+    std::vector<double> p_;
+};
+
+/**
+ * @brief Chaîne d’étages de filtrage appliqués dans l’ordre d’ajout.
+ */
+class FilterPipeline
+{
+public:
+    /// Ajoute un étage en fin de chaîne.
+    void add(std::unique_ptr<FilterStage> stage);
+
+    /// Applique tous les étages au lot, en place.
+    void process(SampleBlock& block);
+
+    /// Réinitialise l’état de tous les étages.
+    void reset();
+
+private:
+    std::vector<std::unique_ptr<FilterStage>> stages_;
+};
+
+}  // namespace bmp390
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bmp390/bmp390_driver.hpp"
+
+namespace bmp390
+{
+
+/**
+ * @brief État publié avec la dernière mesure d’un capteur.
+ */
+enum class SensorStatus : uint32_t
+{
+    Unknown   = 0,  ///< Aucune mesure publiée.
+    Ok        = 1,  ///< Dernière lecture réussie.
+    ReadError = 2,  ///< Dernière lecture en échec (voir error_code).
+    Stale     = 3,  ///< Capteur non rafraîchi dans le délai attendu.
+    Offline   = 4   ///< Écrivain arrêté : plus aucune mise à jour.
+};
+
+/**
+ * @brief Copie cohérente de l’état d’un capteur lue dans le segment partagé.
+ */
+struct Snapshot
+{
+    Measurement  measurement{};
+    SensorStatus status       = SensorStatus::Unknown;
+    int32_t      error_code   = 0;
+    uint64_t     update_count = 0;
+};
+
+/**
+ * @brief Échantillon de l’anneau partagé des mesures récentes.
+ */
+struct RingSample
+{
+    uint32_t     sensor = 0;
+    SensorStatus status = SensorStatus::Unknown;
+    Measurement  measurement{};
+};
+
+namespace shm_detail
+{
+
+/// Nombre de mots 64 bits de la charge utile d’un emplacement capteur.
+constexpr std::size_t kSlotWords = 5;
+
+/// Nombre de mots 64 bits de la charge utile d’une entrée de l’anneau.
+constexpr std::size_t kRingWords = 4;
+
+/**
+ * @brief Emplacement protégé par seqlock (compteur impair = écriture en cours).
+ *
+ * La charge utile est faite d’atomiques 64 bits accédés en relaxed : pas de
+ * course au sens C++, et des accès sans verrou utilisables entre processus.
+ * Aligné sur une ligne de cache pour éviter le faux partage entre capteurs.
+ */
+template <std::size_t Words>
+struct alignas(64) SeqSlot
+{
+    std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> words[Words];
+};
+
+/// En-tête du segment partagé.
+struct alignas(64) Header
+{
+    /// Écrit en dernier (release) : un lecteur ne voit jamais un en-tête partiel.
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t sensor_count;
+    uint32_t ring_capacity;
+
+    /// Nombre total d’échantillons écrits dans l’anneau (position d’écriture).
+    std::atomic<uint64_t> ring_head;
+
+    /// Identifiant de création du segment (change à chaque ShmPublisher::open()).
+    uint64_t epoch;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Le seqlock partagé nécessite des atomiques 64 bits sans verrou");
+
+}  // namespace shm_detail
+
+/**
+ * @brief Publie le dernier état de chaque capteur dans un segment POSIX partagé.
+ *
+ * Un seul écrivain (le thread d’acquisition) ; les lecteurs d’autres
+ * processus (IHM, contrôleur, export) lisent sans verrou et sans jamais
+ * écrire dans le segment : l’écrivain n’est jamais bloqué par eux.
+ * Un anneau optionnel conserve les `ring_capacity` derniers échantillons.
+ */
+class ShmPublisher
+{
+public:
+    /**
+     * @param name          Nom POSIX du segment (ex. "/mirega_sensors").
+     * @param sensor_count  Nombre d’emplacements capteur.
+     * @param ring_capacity Taille de l’anneau d’échantillons (0 : pas d’anneau).
+     */
+    ShmPublisher(const std::string& name, uint32_t sensor_count, uint32_t ring_capacity = 0);
+
+    /// Passe chaque capteur en SensorStatus::Offline, démappe le segment et
+    /// supprime son nom (les lecteurs gardent leur mapping, cf. ShmReader::open()).
+    ~ShmPublisher();
+
+    ShmPublisher(const ShmPublisher&)            = delete;
+    ShmPublisher& operator=(const ShmPublisher&) = delete;
+
+    /**
+     * @brief Crée (ou recrée) et mappe le segment.
+     *
+     * Un segment du même nom laissé par une instance précédente est supprimé :
+     * ses lecteurs le détectent au prochain ShmReader::open().
+     *
+     * @return 0 si succès, -errno en cas d’erreur.
+     */
+    int open();
+
+    /**
+     * @brief Publie l’état d’un capteur (et l’ajoute à l’anneau s’il existe).
+     *
+     * Sans attente ni appel système : quelques écritures atomiques.
+     *
+     * @param sensor     Index du capteur (< sensor_count).
+     * @param m          Dernière mesure.
+     * @param status     État associé.
+     * @param error_code Code d’erreur de la lecture (0 si succès).
+     */
+    void publish(uint32_t sensor, const Measurement& m, SensorStatus status, int32_t error_code = 0);
+
+private:
+    std::string name_;
+    uint32_t    sensor_count_;
+    uint32_t    ring_capacity_;
+
+    int         fd_   = -1;
+    void*       base_ = nullptr;
+    std::size_t size_ = 0;
+
+    shm_detail::Header*                          header_ = nullptr;
+    shm_detail::SeqSlot<shm_detail::kSlotWords>* slots_  = nullptr;
+    shm_detail::SeqSlot<shm_detail::kRingWords>* ring_   = nullptr;
+
+    /// Compteurs de publication, propres à l’écrivain (non lus par les lecteurs).
+    std::vector<uint64_t> update_counts_;
+};
+
+/**
+ * @brief Lecteur sans verrou d’un segment créé par ShmPublisher.
+ *
+ * Les lectures sont de simples chargements mémoire ; une lecture qui croise
+ * une écriture est recommencée, au plus `max_retries` fois.
+ */
+class ShmReader
+{
+public:
+    explicit ShmReader(const std::string& name);
+    ~ShmReader();
+
+    ShmReader(const ShmReader&)            = delete;
+    ShmReader& operator=(const ShmReader&) = delete;
+
+    /**
+     * @brief Mappe le segment en lecture seule et vérifie son en-tête.
+     *
+     * En cas d’échec, le lecteur reste fermé et open() peut être rappelé
+     * (par exemple tant que l’écrivain n’a pas fini de créer le segment).
+     *
+     * Déjà ouvert, open() vérifie que le segment mappé porte toujours son nom
+     * (fstat, st_nlink) ; s’il a été supprimé (écrivain arrêté ou redémarré),
+     * il est démappé et le segment courant est ouvert à sa place (epoch()
+     * change). À rappeler périodiquement pour suivre un redémarrage.
+     *
+     * @return 0 si succès, -errno en cas d’erreur (-EPROTO si format inconnu).
+     */
+    int open();
+
+    /// Nombre de capteurs publiés dans le segment.
+    uint32_t sensor_count() const;
+
+    /// Identifiant de création du segment mappé (0 si fermé).
+    uint64_t epoch() const;
+
+    /**
+     * @brief Lit une copie cohérente de l’état d’un capteur.
+     *
+     * @return false si l’index est invalide ou si l’écrivain a modifié
+     *         l’emplacement pendant chacune des tentatives.
+     */
+    bool read(uint32_t sensor, Snapshot& out, int max_retries = 16) const;
+
+    /**
+     * @brief Récupère les échantillons de l’anneau publiés depuis `cursor`.
+     *
+     * Si le lecteur a pris plus d’un tour de retard, les échantillons
+     * écrasés sont sautés. `cursor` est avancé jusqu’au dernier lu.
+     * Après un changement d’epoch(), repartir de 0 ; un curseur au-delà de la
+     * position d’écriture (segment recréé) y est ramené automatiquement.
+     *
+     * @param out    Vecteur de sortie (les échantillons sont ajoutés en fin).
+     * @param cursor Position de lecture (0 au départ).
+     * @return Nombre d’échantillons écrasés avant d’avoir pu être lus.
+     */
+    uint64_t read_recent(std::vector<RingSample>& out, uint64_t& cursor) const;
+
+private:
+    /// Démappe le segment, ferme le descripteur et remet tous les membres à zéro.
+    void release();
+
+    std::string name_;
+
+    int         fd_   = -1;
+    const void* base_ = nullptr;
+    std::size_t size_ = 0;
+
+    const shm_detail::Header*                          header_ = nullptr;
+    const shm_detail::SeqSlot<shm_detail::kSlotWords>* slots_  = nullptr;
+    const shm_detail::SeqSlot<shm_detail::kRingWords>* ring_   = nullptr;
+};
+
+}  // namespace bmp390
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bmp390/bmp390_driver.hpp"
+
+namespace bmp390
+{
+
+/// Codes de retour du décodeur (0 = succès).
+constexpr int kTelemetryErrTruncated = -1;  ///< Données incomplètes.
+constexpr int kTelemetryErrFormat    = -2;  ///< En-tête ou contenu de bloc invalide.
+
+/// Taille de l’en-tête de bloc, en octets.
+constexpr std::size_t kTelemetryBlockHeaderSize = 20;
+
+/**
+ * @brief Résolutions de quantification et taille des blocs.
+ *
+ * Les valeurs sont arrondies au pas demandé avant codage : l’erreur de
+ * reconstruction est au plus d’un demi-pas.
+ */
+struct TelemetryConfig
+{
+    /// Décimales conservées sur la pression (2 : 0,01 Pa ; bruit BMP390 ≈ 1 Pa).
+    uint8_t pressure_decimals = 2;
+
+    /// Décimales conservées sur la température (3 : 0,001 °C).
+    uint8_t temperature_decimals = 3;
+
+    /// Pas de l’horodatage, en ns (1000 : 1 µs).
+    uint32_t timestamp_quantum_ns = 1000;
+
+    /// Nombre maximal d’échantillons par bloc (1 à 65535).
+    uint16_t block_samples = 256;
+};
+
+/**
+ * @brief En-tête d’un bloc (20 octets, little-endian).
+ *
+ * Chaque bloc se décode seul : ses premières valeurs sont codées en absolu,
+ * et l’en-tête porte les résolutions et la taille du bloc, ce qui permet de
+ * sauter d’un bloc à l’autre sans décoder (accès aléatoire).
+ */
+struct TelemetryBlockHeader
+{
+    uint8_t  version              = 0;
+    uint8_t  pressure_decimals    = 0;
+    uint8_t  temperature_decimals = 0;
+    uint32_t timestamp_quantum_ns = 0;
+    uint16_t sample_count         = 0;
+
+    /// Octets de données suivant l’en-tête.
+    uint32_t payload_bytes = 0;
+};
+
+/**
+ * @brief Encodeur en flux de mesures vers des blocs compacts.
+ *
+ * Par bloc, trois colonnes codées en varint (LEB128) :
+ *  - horodatage : delta de delta (0 pour un pas constant, soit 1 octet),
+ *  - pression et température : delta zigzag par rapport à la dernière
+ *    valeur valide ; le code 0 est réservé aux valeurs NaN.
+ *
+ * Sans allocation en régime établi (tampons réservés à la construction).
+ */
+class TelemetryEncoder
+{
+public:
+    explicit TelemetryEncoder(const TelemetryConfig& config = TelemetryConfig{});
+
+    /**
+     * @brief Ajoute un échantillon ; un bloc plein est ajouté en fin de `out`.
+     */
+    void push(const Measurement& m, std::vector<uint8_t>& out);
+
+    /**
+     * @brief Termine le bloc en cours (s’il n’est pas vide) en fin de `out`.
+     */
+    void flush(std::vector<uint8_t>& out);
+
+    const TelemetryConfig& config() const { return config_; }
+
+private:
+    void reset_block();
+
+    TelemetryConfig config_;
+    double          pressure_scale_;
+    double          temperature_scale_;
+
+    uint16_t count_ = 0;
+
+    // Prédicteurs du bloc courant (valeurs quantifiées)
+    int64_t last_ts_       = 0;
+    int64_t last_ts_delta_ = 0;
+    int64_t last_press_    = 0;
+    int64_t last_temp_     = 0;
+
+    std::vector<uint8_t> ts_col_;
+    std::vector<uint8_t> press_col_;
+    std::vector<uint8_t> temp_col_;
+};
+
+/**
+ * @brief Lit et valide l’en-tête du bloc situé en `data`.
+ *
+ * @return 0 si succès, kTelemetryErrTruncated ou kTelemetryErrFormat.
+ */
+int read_block_header(const uint8_t* data, std::size_t size, TelemetryBlockHeader& header);
+
+/**
+ * @brief Décode un bloc et ajoute ses échantillons en fin de `out`.
+ *
+ * @param data     Début du bloc (en-tête compris).
+ * @param size     Octets disponibles à partir de `data`.
+ * @param out      Vecteur de sortie.
+ * @param consumed Taille du bloc (en-tête + données), pour passer au suivant.
+ * @return 0 si succès, kTelemetryErrTruncated ou kTelemetryErrFormat.
+ */
+int decode_block(const uint8_t* data, std::size_t size, std::vector<Measurement>& out, std::size_t& consumed);
+
+/**
+ * @brief Indexe un flux de blocs à partir des seuls en-têtes.
+ *
+ * @param offsets Positions de début de chaque bloc (ajoutées en fin).
+ * @return 0 si succès, code d’erreur sur le premier bloc invalide.
+ */
+int index_blocks(const uint8_t* data, std::size_t size, std::vector<std::size_t>& offsets);
+
+}  // namespace bmp390
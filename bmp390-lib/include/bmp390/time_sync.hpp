@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "bmp390/bmp390_driver.hpp"
+
+namespace bmp390
+{
+
+/// Période nominale d’un tick du compteur SENSORTIME (25,6 kHz, soit 39,0625 µs).
+constexpr double kSensorTimeTickNs = 39062.5;
+
+/// Nombre de ticks SENSORTIME par période ODR à 200 Hz (5 ms).
+constexpr uint32_t kSensorTimeTicksAt200Hz = 128;
+
+/**
+ * @brief Retourne la période ODR en ticks SENSORTIME.
+ *
+ * Les ODR du BMP390 sont des divisions par 2^n de 200 Hz : la période est
+ * donc 128 · 2^n ticks, et la grille d’échantillonnage est alignée sur les
+ * bits du compteur.
+ */
+uint32_t odr_period_ticks(Config::OutputDataRate odr);
+
+/**
+ * @brief Reconstruction de l’horloge hôte à partir du compteur SENSORTIME.
+ *
+ * Le compteur 24 bits du capteur reboucle toutes les ~11 minutes et dérive
+ * par rapport à l’horloge hôte (oscillateur interne). Cette classe :
+ *  - étend le compteur sur 64 bits (gestion du rebouclage),
+ *  - estime en ligne l’offset et le taux (ns hôte par tick) par moindres
+ *    carrés pondérés exponentiellement sur les points de synchronisation,
+ *  - rejette les points aberrants (préemption du thread d’acquisition).
+ *
+ * Une instance par capteur, non thread-safe.
+ */
+class SensorClock
+{
+public:
+    /**
+     * @param forgetting      Facteur d’oubli de l’estimateur (0 < f <= 1).
+     * @param max_residual_ns Écart maximal toléré une fois l’estimateur verrouillé.
+     */
+    explicit SensorClock(double forgetting = 0.98, int64_t max_residual_ns = 2000000);
+
+    /**
+     * @brief Étend une valeur 24 bits du compteur sur 64 bits.
+     *
+     * Les valeurs doivent être présentées dans l’ordre chronologique, avec
+     * moins d’un rebouclage (~11 min) entre deux appels.
+     */
+    uint64_t unwrap(uint32_t ticks);
+
+    /**
+     * @brief Ajoute un point de synchronisation (sensor_time, instant hôte).
+     *
+     * @param ticks   Valeur 24 bits du compteur lue sur le capteur.
+     * @param host_ns Instant hôte (steady_clock) correspondant, en ns.
+     * @return true si le point a été retenu par l’estimateur.
+     */
+    bool observe(uint32_t ticks, int64_t host_ns);
+
+    /// Convertit un compteur étendu (cf. unwrap()) en instant hôte (ns).
+    int64_t to_host_ns(uint64_t ticks) const;
+
+    /// Dérive estimée de l’oscillateur capteur, en ppm (0 tant que non verrouillé).
+    double drift_ppm() const;
+
+    /// Vrai dès que deux points de synchronisation distincts ont été observés.
+    bool locked() const { return locked_; }
+
+    /// Réinitialise l’estimateur (ex. après un soft reset du capteur).
+    void reset();
+
+private:
+    double   forgetting_;
+    int64_t  max_residual_ns_;
+
+    bool     has_last_ = false;
+    uint32_t last_raw_ = 0;
+    uint64_t epoch_    = 0;
+
+    /// Origine des régressions (évite la perte de précision sur les doubles).
+    bool     has_ref_  = false;
+    uint64_t ref_ticks_ = 0;
+    int64_t  ref_host_  = 0;
+
+    /// Statistiques pondérées (x = ticks, y = ns hôte) : poids, moyennes, co-moments.
+    double sw_ = 0.0, mx_ = 0.0, my_ = 0.0, cxx_ = 0.0, cxy_ = 0.0;
+
+    /// Modèle courant : host = ref_host_ + offset_ + rate_ * (ticks - ref_ticks_).
+    double offset_  = 0.0;
+    double rate_    = kSensorTimeTickNs;
+    bool   locked_  = false;
+    int    rejects_ = 0;
+};
+
+/**
+ * @brief Trame alignée : un échantillon par capteur à un instant commun.
+ */
+struct AlignedFrame
+{
+    /// Instant de la grille commune (ns hôte).
+    int64_t timestamp_ns = 0;
+
+    /// Échantillons interpolés, indexés par capteur (NaN si indisponible).
+    std::vector<Measurement> samples;
+};
+
+/**
+ * @brief Ré-échantillonne plusieurs flux horodatés sur une grille commune.
+ *
+ * Chaque capteur pousse ses mesures (horodatées, dans l’ordre) ; une trame
+ * est produite pour l’instant t de la grille dès que tous les capteurs ont
+ * un échantillon postérieur à t (interpolation linéaire), ou lorsque le flux
+ * le plus en avance dépasse t de `max_latency_ns` (les retardataires sont
+ * alors marqués NaN). Prévu pour la fusion de données multi-capteurs.
+ */
+class TimeAligner
+{
+public:
+    /**
+     * @param sensor_count   Nombre de flux à aligner.
+     * @param period_ns      Pas de la grille commune (ns).
+     * @param max_latency_ns Attente maximale d’un flux en retard (ns).
+     */
+    TimeAligner(std::size_t sensor_count, int64_t period_ns, int64_t max_latency_ns);
+
+    /**
+     * @brief Ajoute une mesure horodatée au flux `sensor`.
+     *
+     * Les mesures non horodatées ou antérieures à la précédente sont ignorées.
+     */
+    void push(std::size_t sensor, const Measurement& m);
+
+    /**
+     * @brief Extrait la prochaine trame alignée si elle est disponible.
+     *
+     * @param out Trame de sortie (le vecteur `samples` est réutilisé).
+     * @return true si une trame a été produite.
+     */
+    bool pop(AlignedFrame& out);
+
+private:
+    std::vector<std::deque<Measurement>> tracks_;
+    int64_t period_ns_;
+    int64_t max_latency_ns_;
+    int64_t next_ns_   = 0;
+    int64_t newest_ns_ = 0;
+    bool    started_   = false;
+};
+
+}  // namespace bmp390
@@ -1,10 +1,31 @@
 #include "bmp390/bmp390_driver.hpp"
 
+#include <chrono>
+
+#include "bmp390/compensation.hpp"
+#include "bmp390/time_sync.hpp"
 #include "third_party/bmp3.h"
 
 namespace bmp390
 {
 
+// Registre SENSORTIME_0 (compteur 24 bits, LSB en premier), absent de bmp3_defs.h
+static constexpr uint8_t kRegSensorTime = 0x0C;
+
+// Rafale DATA_0 (0x04) .. SENSORTIME_2 (0x0E) : données, 2 registres réservés, compteur
+static constexpr uint8_t kLenDataSensorTime = kRegSensorTime + BMP3_LEN_SENSOR_TIME - BMP3_REG_DATA;
+
+// Taille du FIFO matériel + octets de la trame sensor_time (cf. bmp3_get_fifo_data)
+static constexpr uint16_t kFifoBufferSize = 512 + BMP3_SENSORTIME_OVERHEAD_BYTES;
+
+// Horloge hôte monotone utilisée pour l’horodatage des mesures
+static int64_t host_now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
 // Helpers de mapping Config -> macros BMP3
 static uint8_t map_oversampling(Config::Oversampling os)
 {
@@ -59,6 +80,17 @@ static uint8_t map_iir_filter(Config::IirFilterCoeff coeff)
     }
 }
 
+// Même découpage que parse_sensor_data (bmp3.c) : pression puis température, LSB en premier
+static void parse_raw_data(const uint8_t* reg_data, RawMeasurement& out)
+{
+    out.pressure = static_cast<uint32_t>(reg_data[0]) |
+                   (static_cast<uint32_t>(reg_data[1]) << 8) |
+                   (static_cast<uint32_t>(reg_data[2]) << 16);
+    out.temperature = static_cast<uint32_t>(reg_data[3]) |
+                      (static_cast<uint32_t>(reg_data[4]) << 8) |
+                      (static_cast<uint32_t>(reg_data[5]) << 16);
+}
+
 // Callbacks d’adaptation entre BusInterface (reg, data, len) et bmp3 (reg_addr, reg_data, len)
 static BMP3_INTF_RET_TYPE bmp3_bus_read(uint8_t reg_addr, uint8_t *reg_data, uint32_t length, void *intf_ptr)
 {
@@ -132,9 +164,9 @@ int Bmp390::init()
         return -1;
     }
 
-    // Configuration de la structure bmp3_dev
-    dev_->dev_id = dev_id_;
-    dev_->intf   = use_i2c_ ? BMP3_I2C_INTF : BMP3_SPI_INTF;
+    // Configuration de la structure bmp3_dev (bmp3_dev n’a pas de champ
+    // d’adresse : les callbacks de l’application visent dev_id())
+    dev_->intf = use_i2c_ ? BMP3_I2C_INTF : BMP3_SPI_INTF;
 
     // On passe le BusInterface via intf_ptr pour l’utiliser dans les callbacks
     dev_->intf_ptr = &bus_;
@@ -146,6 +178,17 @@ int Bmp390::init()
     // Initialisation du capteur
     int8_t rslt = bmp3_init(dev_);
 
+    // Copie immuable de la calibration pour la compensation différée (read_raw)
+    if (rslt == BMP3_OK)
+    {
+        uint8_t nvm[BMP3_LEN_CALIB_DATA] = {};
+        rslt = bmp3_get_regs(BMP3_REG_CALIB_DATA, nvm, BMP3_LEN_CALIB_DATA, dev_);
+        if (rslt == BMP3_OK)
+        {
+            calibration_ = std::make_shared<const Calibration>(make_calibration(nvm));
+        }
+    }
+
     // TODO: Optionnellement, effectuer un soft reset après init
     // if (rslt == BMP3_OK)
     // {
@@ -170,14 +213,14 @@ int Bmp390::configure(const Config& config)
     settings.temp_en  = BMP3_ENABLE;
 
     // Oversampling
-    settings.press_os = map_oversampling(config.pressure_oversampling);
-    settings.temp_os  = map_oversampling(config.temperature_oversampling);
+    settings.odr_filter.press_os = map_oversampling(config.pressure_oversampling);
+    settings.odr_filter.temp_os  = map_oversampling(config.temperature_oversampling);
 
     // ODR
-    settings.odr = map_odr(config.odr);
+    settings.odr_filter.odr = map_odr(config.odr);
 
     // Filtre IIR
-    settings.iir_filter = map_iir_filter(config.iir_filter);
+    settings.odr_filter.iir_filter = map_iir_filter(config.iir_filter);
 
     // Indique quels champs on souhaite configurer
     uint32_t desired_settings = 0;
@@ -194,14 +237,36 @@ int Bmp390::configure(const Config& config)
         return static_cast<int>(rslt);
     }
 
-    // Choix d’un mode simple : normal mode
-    settings.op_mode = BMP3_MODE_NORMAL;
+    // FIFO pression + température + trame sensor_time (datation des lots)
+    if (config.fifo_enabled)
+    {
+        bmp3_fifo_settings fifo_settings{};
+        fifo_settings.mode          = BMP3_ENABLE;
+        fifo_settings.press_en      = BMP3_ENABLE;
+        fifo_settings.temp_en       = BMP3_ENABLE;
+        fifo_settings.time_en       = BMP3_ENABLE;
+        fifo_settings.down_sampling = BMP3_FIFO_NO_SUBSAMPLING;
+
+        uint16_t fifo_desired = BMP3_SEL_FIFO_MODE | BMP3_SEL_FIFO_PRESS_EN | BMP3_SEL_FIFO_TEMP_EN |
+                                BMP3_SEL_FIFO_TIME_EN | BMP3_SEL_FIFO_DOWN_SAMPLING;
+
+        rslt = bmp3_set_fifo_settings(fifo_desired, &fifo_settings, dev_);
+        if (rslt != BMP3_OK)
+        {
+            return static_cast<int>(rslt);
+        }
+    }
+
+    // Mode normal : conversions à l’ODR ; mode forced : veille jusqu’au trigger
+    settings.op_mode = config.power_mode == Config::PowerMode::Forced ? BMP3_MODE_SLEEP : BMP3_MODE_NORMAL;
     rslt = bmp3_set_op_mode(&settings, dev_);
     if (rslt != BMP3_OK)
     {
         return static_cast<int>(rslt);
     }
 
+    config_ = config;
+
     return static_cast<int>(rslt);
 }
 
@@ -230,6 +295,189 @@ int Bmp390::read_measurement(Measurement& out)
     out.temperature_c = static_cast<double>(data.temperature);
 #endif
 
+    // Horodatage à la réception ; voir la surcharge SensorClock pour une
+    // datation sur l’horloge du capteur.
+    out.timestamp_ns = host_now_ns();
+
+    return static_cast<int>(rslt);
+}
+
+int Bmp390::trigger_measurement()
+{
+    if (!dev_)
+    {
+        return -1;
+    }
+
+    if (config_.power_mode != Config::PowerMode::Forced)
+    {
+        return BMP3_E_CONFIGURATION_ERR;
+    }
+
+    // Le capteur repasse seul en veille à la fin de chaque conversion forced
+    bmp3_settings settings{};
+    settings.op_mode = BMP3_MODE_FORCED;
+
+    return static_cast<int>(bmp3_set_op_mode(&settings, dev_));
+}
+
+uint32_t Bmp390::conversion_time_us() const
+{
+    // Oversampling::Xn vaut log2(n) : 2^osr = 1 << valeur de l’enum
+    const uint32_t press_os = 1U << static_cast<uint8_t>(config_.pressure_oversampling);
+    const uint32_t temp_os  = 1U << static_cast<uint8_t>(config_.temperature_oversampling);
+
+    return 234U + (392U + press_os * 2020U) + (163U + temp_os * 2020U);
+}
+
+int Bmp390::read_measurement(Measurement& out, SensorClock& clock)
+{
+    if (!dev_ || !calibration_)
+    {
+        return -1;
+    }
+
+    // Datation sur la grille ODR : elle n’existe qu’en mode normal
+    if (config_.power_mode != Config::PowerMode::Normal)
+    {
+        return BMP3_E_CONFIGURATION_ERR;
+    }
+
+    // Une seule lecture en rafale : le capteur fige ses registres pendant la
+    // rafale, mesure et SENSORTIME proviennent donc du même instantané (deux
+    // transactions séparées dateraient d’une période trop tard la mesure
+    // lue juste avant un tick ODR).
+    uint8_t reg_data[kLenDataSensorTime] = {};
+    int8_t rslt = bmp3_get_regs(BMP3_REG_DATA, reg_data, kLenDataSensorTime, dev_);
+    if (rslt != BMP3_OK)
+    {
+        return static_cast<int>(rslt);
+    }
+
+    // L’instant hôte le plus proche de la lecture de SENSORTIME est la fin du transfert
+    const int64_t host_ns = host_now_ns();
+
+    RawMeasurement raw{};
+    parse_raw_data(reg_data, raw);
+    out = compensate(raw, *calibration_);
+
+    const uint8_t* time_data = reg_data + (kRegSensorTime - BMP3_REG_DATA);
+    const uint32_t ticks = static_cast<uint32_t>(time_data[0]) |
+                           (static_cast<uint32_t>(time_data[1]) << 8) |
+                           (static_cast<uint32_t>(time_data[2]) << 16);
+    clock.observe(ticks, host_ns);
+
+    // En mode normal, la mesure lue est la dernière de la grille ODR, alignée
+    // sur les bits du compteur (période = 128 · 2^n ticks).
+    const uint64_t period = odr_period_ticks(config_.odr);
+    const uint64_t now    = clock.unwrap(ticks);
+    out.timestamp_ns = clock.to_host_ns(now - (now % period));
+
+    return BMP3_OK;
+}
+
+int Bmp390::read_sensor_time(uint32_t& ticks)
+{
+    if (!dev_)
+    {
+        return -1;
+    }
+
+    uint8_t reg_data[BMP3_LEN_SENSOR_TIME] = {};
+    int8_t rslt = bmp3_get_regs(kRegSensorTime, reg_data, BMP3_LEN_SENSOR_TIME, dev_);
+    if (rslt != BMP3_OK)
+    {
+        return static_cast<int>(rslt);
+    }
+
+    ticks = static_cast<uint32_t>(reg_data[0]) |
+            (static_cast<uint32_t>(reg_data[1]) << 8) |
+            (static_cast<uint32_t>(reg_data[2]) << 16);
+
+    return static_cast<int>(rslt);
+}
+
+int Bmp390::read_raw(RawMeasurement& out)
+{
+    if (!dev_)
+    {
+        return -1;
+    }
+
+    uint8_t reg_data[BMP3_LEN_P_T_DATA] = {};
+    int8_t rslt = bmp3_get_regs(BMP3_REG_DATA, reg_data, BMP3_LEN_P_T_DATA, dev_);
+    if (rslt != BMP3_OK)
+    {
+        return static_cast<int>(rslt);
+    }
+
+    parse_raw_data(reg_data, out);
+    out.timestamp_ns = host_now_ns();
+
+    return static_cast<int>(rslt);
+}
+
+int Bmp390::read_fifo(std::vector<Measurement>& out, SensorClock& clock)
+{
+    if (!dev_)
+    {
+        return -1;
+    }
+
+    // Trames datées en remontant la grille ODR : mode normal uniquement
+    if (!config_.fifo_enabled || config_.power_mode != Config::PowerMode::Normal)
+    {
+        return BMP3_E_CONFIGURATION_ERR;
+    }
+
+    bmp3_fifo_settings fifo_settings{};
+    fifo_settings.mode     = BMP3_ENABLE;
+    fifo_settings.press_en = BMP3_ENABLE;
+    fifo_settings.temp_en  = BMP3_ENABLE;
+    fifo_settings.time_en  = BMP3_ENABLE;
+
+    uint8_t buffer[kFifoBufferSize] = {};
+    bmp3_fifo_data fifo{};
+    fifo.buffer = buffer;
+
+    int8_t rslt = bmp3_get_fifo_data(&fifo, &fifo_settings, dev_);
+    if (rslt != BMP3_OK)
+    {
+        return static_cast<int>(rslt);
+    }
+
+    // La trame sensor_time est émise à la lecture du FIFO vide : fin du transfert
+    const int64_t host_ns = host_now_ns();
+
+    bmp3_data frames[BMP3_FIFO_MAX_FRAMES] = {};
+    rslt = bmp3_extract_fifo_data(frames, &fifo, dev_);
+    if (rslt != BMP3_OK)
+    {
+        return static_cast<int>(rslt);
+    }
+
+    const std::size_t count = fifo.parsed_frames;
+    if (count == 0)
+    {
+        return static_cast<int>(rslt);
+    }
+
+    // Dernière trame sur la grille ODR, les précédentes espacées d’une période
+    clock.observe(fifo.sensor_time, host_ns);
+    const uint64_t period = odr_period_ticks(config_.odr);
+    const uint64_t now    = clock.unwrap(fifo.sensor_time);
+    const uint64_t last   = now - (now % period);
+
+    out.reserve(out.size() + count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Measurement m{};
+        m.pressure_pa   = static_cast<double>(frames[i].pressure);
+        m.temperature_c = static_cast<double>(frames[i].temperature);
+        m.timestamp_ns  = clock.to_host_ns(last - (count - 1 - i) * period);
+        out.push_back(m);
+    }
+
     return static_cast<int>(rslt);
 }
 
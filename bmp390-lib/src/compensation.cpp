@@ -0,0 +1,92 @@
+#include "bmp390/compensation.hpp"
+
+#include <algorithm>
+
+namespace bmp390
+{
+
+// Bornes de la compensation Bosch (BMP3_MIN/MAX_TEMP_DOUBLE, BMP3_MIN/MAX_PRES_DOUBLE)
+static constexpr double kMinTempC    = -40.0;
+static constexpr double kMaxTempC    = 85.0;
+static constexpr double kMinPressPa  = 30000.0;
+static constexpr double kMaxPressPa  = 125000.0;
+
+static uint16_t concat_bytes(uint8_t msb, uint8_t lsb)
+{
+    return static_cast<uint16_t>((static_cast<uint16_t>(msb) << 8) | lsb);
+}
+
+// Équivalent de pow_bmp3 (bmp3.c) : calcul en float, conservé pour des
+// résultats identiques à bmp3_get_sensor_data.
+static float pow_bmp3(double base, uint8_t power)
+{
+    float out = 1.0f;
+    while (power != 0)
+    {
+        out = static_cast<float>(base) * out;
+        --power;
+    }
+    return out;
+}
+
+Calibration make_calibration(const uint8_t* nvm)
+{
+    Calibration c{};
+    std::copy(nvm, nvm + kCalibrationNvmSize, c.nvm.begin());
+
+    // Quantification identique à parse_calib_data (bmp3.c, BMP3_FLOAT_COMPENSATION)
+    c.par_t1  = static_cast<double>(concat_bytes(nvm[1], nvm[0])) / 0.00390625;
+    c.par_t2  = static_cast<double>(concat_bytes(nvm[3], nvm[2])) / 1073741824.0;
+    c.par_t3  = static_cast<double>(static_cast<int8_t>(nvm[4])) / 281474976710656.0;
+    c.par_p1  = static_cast<double>(static_cast<int16_t>(concat_bytes(nvm[6], nvm[5])) - 16384) / 1048576.0;
+    c.par_p2  = static_cast<double>(static_cast<int16_t>(concat_bytes(nvm[8], nvm[7])) - 16384) / 536870912.0;
+    c.par_p3  = static_cast<double>(static_cast<int8_t>(nvm[9])) / 4294967296.0;
+    c.par_p4  = static_cast<double>(static_cast<int8_t>(nvm[10])) / 137438953472.0;
+    c.par_p5  = static_cast<double>(concat_bytes(nvm[12], nvm[11])) / 0.125;
+    c.par_p6  = static_cast<double>(concat_bytes(nvm[14], nvm[13])) / 64.0;
+    c.par_p7  = static_cast<double>(static_cast<int8_t>(nvm[15])) / 256.0;
+    c.par_p8  = static_cast<double>(static_cast<int8_t>(nvm[16])) / 32768.0;
+    c.par_p9  = static_cast<double>(static_cast<int16_t>(concat_bytes(nvm[18], nvm[17]))) / 281474976710656.0;
+    c.par_p10 = static_cast<double>(static_cast<int8_t>(nvm[19])) / 281474976710656.0;
+    c.par_p11 = static_cast<double>(static_cast<int8_t>(nvm[20])) / 36893488147419103232.0;
+
+    return c;
+}
+
+Measurement compensate(const RawMeasurement& raw, const Calibration& calib)
+{
+    // Température (compensate_temperature) : t_lin sert aussi à la pression
+    const double pd1   = static_cast<double>(raw.temperature) - calib.par_t1;
+    const double pd2   = pd1 * calib.par_t2;
+    const double t_lin = std::min(std::max(pd2 + (pd1 * pd1) * calib.par_t3, kMinTempC), kMaxTempC);
+
+    // Pression (compensate_pressure)
+    const double up = static_cast<double>(raw.pressure);
+
+    const double out1 = calib.par_p5 +
+                        calib.par_p6 * t_lin +
+                        calib.par_p7 * pow_bmp3(t_lin, 2) +
+                        calib.par_p8 * pow_bmp3(t_lin, 3);
+    const double out2 = up * (calib.par_p1 +
+                              calib.par_p2 * t_lin +
+                              calib.par_p3 * pow_bmp3(t_lin, 2) +
+                              calib.par_p4 * pow_bmp3(t_lin, 3));
+    const double out3 = pow_bmp3(up, 2) * (calib.par_p9 + calib.par_p10 * t_lin) +
+                        pow_bmp3(up, 3) * calib.par_p11;
+
+    Measurement m{};
+    m.pressure_pa   = std::min(std::max(out1 + out2 + out3, kMinPressPa), kMaxPressPa);
+    m.temperature_c = t_lin;
+    m.timestamp_ns  = raw.timestamp_ns;
+    return m;
+}
+
+void compensate(const RawMeasurement* raw, std::size_t count, const Calibration& calib, Measurement* out)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = compensate(raw[i], calib);
+    }
+}
+
+}  // namespace bmp390
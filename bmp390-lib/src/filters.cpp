@@ -0,0 +1,447 @@
+#include "bmp390/filters.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "bmp390/time_sync.hpp"
+
+namespace bmp390
+{
+
+static constexpr double kPi = 3.14159265358979323846;
+
+// Covariance initiale du Kalman : la première mesure valide fixe l’état
+static constexpr double kKalmanInitialVariance = 1e12;
+
+// Accès à la colonne de valeurs correspondant à une grandeur
+static double* field_data(SampleBlock& block, Field field)
+{
+    switch (field)
+    {
+        case Field::Pressure:    return block.pressure_pa.data();
+        case Field::Temperature: return block.temperature_c.data();
+        case Field::Altitude:    return block.altitude_m.data();
+        default:                 return block.pressure_pa.data();
+    }
+}
+
+// Masque de validité sans branchement : 1.0 si v est un nombre, 0.0 si NaN.
+// Les boucles par capteur combinent ce masque arithmétiquement plutôt que par
+// des `if`, pour rester vectorisables (GCC/Clang, -O3 -fno-trapping-math).
+static inline double valid_mask(double v)
+{
+    return static_cast<double>(v == v);
+}
+
+// Valeur assainie : v si valide, 0.0 sinon (n’empoisonne pas l’état).
+static inline double sanitize(double v)
+{
+    return v == v ? v : 0.0;
+}
+
+// Redimensionne un état par capteur ; retourne true s’il a été réinitialisé
+static bool ensure_state(std::vector<double>& state, std::size_t channels, double value)
+{
+    if (state.size() == channels)
+    {
+        return false;
+    }
+    state.assign(channels, value);
+    return true;
+}
+
+// ============================================================================
+// SampleBlock
+// ============================================================================
+
+void SampleBlock::resize(std::size_t channel_count, std::size_t frame_count)
+{
+    channels = channel_count;
+    frames   = frame_count;
+
+    const std::size_t n = channel_count * frame_count;
+    pressure_pa.assign(n, 0.0);
+    temperature_c.assign(n, 0.0);
+    altitude_m.assign(n, std::numeric_limits<double>::quiet_NaN());
+    timestamp_ns.assign(frame_count, 0);
+}
+
+void SampleBlock::append(const AlignedFrame& frame)
+{
+    if (channels == 0 && frames == 0)
+    {
+        channels = frame.samples.size();
+    }
+    if (frame.samples.size() != channels)
+    {
+        return;
+    }
+
+    for (const Measurement& m : frame.samples)
+    {
+        pressure_pa.push_back(m.pressure_pa);
+        temperature_c.push_back(m.temperature_c);
+        altitude_m.push_back(std::numeric_limits<double>::quiet_NaN());
+    }
+    timestamp_ns.push_back(frame.timestamp_ns);
+    ++frames;
+}
+
+void SampleBlock::set(std::size_t frame, std::size_t channel, const Measurement& m)
+{
+    const std::size_t i = frame * channels + channel;
+    pressure_pa[i]      = m.pressure_pa;
+    temperature_c[i]    = m.temperature_c;
+    timestamp_ns[frame] = m.timestamp_ns;
+}
+
+Measurement SampleBlock::get(std::size_t frame, std::size_t channel) const
+{
+    const std::size_t i = frame * channels + channel;
+
+    Measurement m{};
+    m.pressure_pa   = pressure_pa[i];
+    m.temperature_c = temperature_c[i];
+    m.timestamp_ns  = timestamp_ns[frame];
+    return m;
+}
+
+// ============================================================================
+// Decimator
+// ============================================================================
+
+// Cumul des valeurs valides d’un instant, capteur par capteur
+static void accumulate(double* acc, double* count, const double* in, std::size_t n)
+{
+    for (std::size_t c = 0; c < n; ++c)
+    {
+        acc[c]   += sanitize(in[c]);
+        count[c] += valid_mask(in[c]);
+    }
+}
+
+// Moyenne du groupe puis remise à zéro (groupe sans valeur valide : 0 / 0 = NaN)
+static void flush_average(double* out, double* acc, double* count, std::size_t n)
+{
+    for (std::size_t c = 0; c < n; ++c)
+    {
+        out[c]   = acc[c] / count[c];
+        acc[c]   = 0.0;
+        count[c] = 0.0;
+    }
+}
+
+Decimator::Decimator(std::size_t factor)
+    : factor_(factor > 0 ? factor : 1)
+{
+}
+
+void Decimator::process(SampleBlock& block)
+{
+    const std::size_t nch = block.channels;
+    if (ensure_state(acc_p_, nch, 0.0))
+    {
+        acc_t_.assign(nch, 0.0);
+        acc_a_.assign(nch, 0.0);
+        count_p_.assign(nch, 0.0);
+        count_t_.assign(nch, 0.0);
+        count_a_.assign(nch, 0.0);
+        pending_ = 0;
+    }
+
+    // Altitude absente (pas d’AltitudeKalman en amont) : NaN, décimés comme le reste
+    block.altitude_m.resize(block.frames * nch, std::numeric_limits<double>::quiet_NaN());
+
+    double* p = block.pressure_pa.data();
+    double* t = block.temperature_c.data();
+    double* a = block.altitude_m.data();
+    double* acc_p = acc_p_.data();
+    double* acc_t = acc_t_.data();
+    double* acc_a = acc_a_.data();
+    double* cnt_p = count_p_.data();
+    double* cnt_t = count_t_.data();
+    double* cnt_a = count_a_.data();
+
+    std::size_t out_frames = 0;
+
+    for (std::size_t f = 0; f < block.frames; ++f)
+    {
+        if (pending_ == 0)
+        {
+            first_ts_ = block.timestamp_ns[f];
+        }
+
+        const double* in_p = p + f * nch;
+        const double* in_t = t + f * nch;
+        accumulate(acc_p, cnt_p, in_p, nch);
+        accumulate(acc_t, cnt_t, in_t, nch);
+        accumulate(acc_a, cnt_a, a + f * nch, nch);
+
+        if (++pending_ < factor_)
+        {
+            continue;
+        }
+
+        // Groupe complet : écriture en place (out_frames <= f, pas de recouvrement gênant)
+        double* out_p = p + out_frames * nch;
+        double* out_t = t + out_frames * nch;
+        flush_average(out_p, acc_p, cnt_p, nch);
+        flush_average(out_t, acc_t, cnt_t, nch);
+        flush_average(a + out_frames * nch, acc_a, cnt_a, nch);
+        block.timestamp_ns[out_frames] = first_ts_ + (block.timestamp_ns[f] - first_ts_) / 2;
+
+        ++out_frames;
+        pending_ = 0;
+    }
+
+    block.frames = out_frames;
+    block.pressure_pa.resize(out_frames * nch);
+    block.temperature_c.resize(out_frames * nch);
+    block.altitude_m.resize(out_frames * nch);
+    block.timestamp_ns.resize(out_frames);
+}
+
+void Decimator::reset()
+{
+    pending_ = 0;
+    acc_p_.clear();
+    acc_t_.clear();
+    acc_a_.clear();
+    count_p_.clear();
+    count_t_.clear();
+    count_a_.clear();
+}
+
+// ============================================================================
+// Biquad
+// ============================================================================
+
+BiquadCoeffs BiquadCoeffs::lowpass(double sample_rate_hz, double cutoff_hz, double q)
+{
+    const double w0    = 2.0 * kPi * cutoff_hz / sample_rate_hz;
+    const double cosw  = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double a0    = 1.0 + alpha;
+
+    BiquadCoeffs c{};
+    c.b0 = (1.0 - cosw) / 2.0 / a0;
+    c.b1 = (1.0 - cosw) / a0;
+    c.b2 = c.b0;
+    c.a1 = -2.0 * cosw / a0;
+    c.a2 = (1.0 - alpha) / a0;
+    return c;
+}
+
+Biquad::Biquad(Field field, const BiquadCoeffs& coeffs)
+    : field_(field),
+      c_(coeffs)
+{
+}
+
+void Biquad::process(SampleBlock& block)
+{
+    const std::size_t nch = block.channels;
+    if (ensure_state(z1_, nch, 0.0))
+    {
+        z2_.assign(nch, 0.0);
+        primed_.assign(nch, 0.0);
+    }
+
+    double* x      = field_data(block, field_);
+    double* z1     = z1_.data();
+    double* z2     = z2_.data();
+    double* primed = primed_.data();
+
+    const double b0 = c_.b0, b1 = c_.b1, b2 = c_.b2, a1 = c_.a1, a2 = c_.a2;
+    const double dc_gain = (b0 + b1 + b2) / (1.0 + a1 + a2);
+
+    for (std::size_t f = 0; f < block.frames; ++f)
+    {
+        double* row = x + f * nch;
+        for (std::size_t c = 0; c < nch; ++c)
+        {
+            const double raw = row[c];
+            const double in  = sanitize(raw);
+            const double ok  = valid_mask(raw);
+
+            // Première valeur valide : état initialisé en régime établi (évite
+            // le transitoire depuis 0, très long pour une pression de ~1e5 Pa).
+            const double init = ok * (1.0 - primed[c]);
+            const double y0   = in * dc_gain;
+            const double s1   = z1[c] + init * ((y0 - b0 * in) - z1[c]);
+            const double s2   = z2[c] + init * ((b2 * in - a2 * y0) - z2[c]);
+            const double y    = b0 * in + s1;
+
+            // Échantillon NaN : état inchangé, NaN propagé en sortie (raw - raw)
+            z1[c]     = s1 + ok * ((b1 * in - a1 * y + s2) - s1);
+            z2[c]     = s2 + ok * ((b2 * in - a2 * y) - s2);
+            primed[c] = primed[c] + init;
+            row[c]    = y + (raw - raw);
+        }
+    }
+}
+
+void Biquad::reset()
+{
+    z1_.clear();
+    z2_.clear();
+    primed_.clear();
+}
+
+// ============================================================================
+// MedianDespike
+// ============================================================================
+
+MedianDespike::MedianDespike(Field field, double threshold)
+    : field_(field),
+      threshold_(threshold)
+{
+}
+
+void MedianDespike::process(SampleBlock& block)
+{
+    const std::size_t nch = block.channels;
+    if (ensure_state(prev1_, nch, 0.0))
+    {
+        prev2_.assign(nch, 0.0);
+        history_.assign(nch, 0.0);
+    }
+
+    double* x  = field_data(block, field_);
+    double* p1 = prev1_.data();
+    double* p2 = prev2_.data();
+    double* h  = history_.data();
+
+    for (std::size_t f = 0; f < block.frames; ++f)
+    {
+        double* row = x + f * nch;
+
+        for (std::size_t c = 0; c < nch; ++c)
+        {
+            const double in = row[c];
+            const double a  = p2[c];
+            const double b  = p1[c];
+
+            // Amorçage par capteur sur ses deux premiers échantillons valides :
+            // sortie non filtrée tant que l’historique est incomplet
+            const double primed = static_cast<double>(h[c] >= 2.0);
+
+            // Médiane de 3 par réseau min/max (sans branchement) ; a et b sont
+            // toujours valides, un NaN en entrée ressort tel quel
+            const double med   = std::max(std::min(a, b), std::min(std::max(a, b), in));
+            const double spike = primed * static_cast<double>(std::fabs(in - med) > threshold_);
+            const double out   = in + spike * (med - in);
+
+            // L’historique garde les entrées brutes (et non la sortie) pour
+            // suivre un échelon ; échantillon NaN : historique inchangé
+            const double ok = valid_mask(in);
+            row[c] = out;
+            p2[c]  = a + ok * (b - a);
+            p1[c]  = b + ok * (sanitize(in) - b);
+            h[c]   = std::min(h[c] + ok, 2.0);
+        }
+    }
+}
+
+void MedianDespike::reset()
+{
+    prev1_.clear();
+    prev2_.clear();
+    history_.clear();
+}
+
+// ============================================================================
+// AltitudeKalman
+// ============================================================================
+
+AltitudeKalman::AltitudeKalman(double process_noise_m2, double measurement_noise_m2, double sea_level_pa)
+    : q_(process_noise_m2),
+      r_(measurement_noise_m2),
+      sea_level_pa_(sea_level_pa)
+{
+}
+
+void AltitudeKalman::process(SampleBlock& block)
+{
+    const std::size_t nch = block.channels;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    if (ensure_state(x_, nch, 0.0))
+    {
+        p_.assign(nch, kKalmanInitialVariance);
+    }
+
+    block.altitude_m.resize(block.frames * nch, nan);
+
+    const double* pr  = block.pressure_pa.data();
+    double*       alt = block.altitude_m.data();
+    double*       x   = x_.data();
+    double*       p   = p_.data();
+
+    const double inv_p0   = 1.0 / sea_level_pa_;
+    const double exponent = 1.0 / 5.255;
+
+    for (std::size_t f = 0; f < block.frames; ++f)
+    {
+        const double* row_p = pr + f * nch;
+        double*       row_a = alt + f * nch;
+
+        // Conversion pression -> altitude (pow non vectorisé sans libmvec,
+        // gardé dans une boucle séparée pour ne pas bloquer la suivante)
+        for (std::size_t c = 0; c < nch; ++c)
+        {
+            row_a[c] = 44330.0 * (1.0 - std::pow(row_p[c] * inv_p0, exponent));
+        }
+
+        for (std::size_t c = 0; c < nch; ++c)
+        {
+            const double z  = row_a[c];
+            const double ok = valid_mask(z);
+
+            // Prédiction (marche aléatoire) puis correction
+            const double pp = p[c] + q_;
+            const double k  = ok * (pp / (pp + r_));
+
+            x[c]     = x[c] + k * (sanitize(z) - x[c]);
+            p[c]     = p[c] + ok * ((1.0 - k) * pp - p[c]);
+            row_a[c] = x[c] + (z - z);
+        }
+    }
+}
+
+void AltitudeKalman::reset()
+{
+    x_.clear();
+    p_.clear();
+}
+
+// ============================================================================
+// FilterPipeline
+// ============================================================================
+
+void FilterPipeline::add(std::unique_ptr<FilterStage> stage)
+{
+    if (stage)
+    {
+        stages_.push_back(std::move(stage));
+    }
+}
+
+void FilterPipeline::process(SampleBlock& block)
+{
+    for (const auto& stage : stages_)
+    {
+        stage->process(block);
+    }
+}
+
+void FilterPipeline::reset()
+{
+    for (const auto& stage : stages_)
+    {
+        stage->reset();
+    }
+}
+
+}  // namespace bmp390
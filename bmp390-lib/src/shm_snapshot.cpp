@@ -0,0 +1,407 @@
+#include "bmp390/shm_snapshot.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bmp390
+{
+
+using shm_detail::Header;
+using shm_detail::kRingWords;
+using shm_detail::kSlotWords;
+using shm_detail::SeqSlot;
+
+// "BMPS" : identifie un segment produit par ShmPublisher
+static constexpr uint32_t kShmMagic   = 0x53504D42U;
+static constexpr uint32_t kShmVersion = 2;
+
+// Taille du segment : en-tête, emplacements capteur puis anneau
+static std::size_t segment_size(uint32_t sensor_count, uint32_t ring_capacity)
+{
+    return sizeof(Header) +
+           sizeof(SeqSlot<kSlotWords>) * sensor_count +
+           sizeof(SeqSlot<kRingWords>) * ring_capacity;
+}
+
+static uint64_t double_bits(double v)
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+static double bits_double(uint64_t bits)
+{
+    double v = 0.0;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// Écriture seqlock : compteur impair, charge utile, compteur pair suivant
+template <std::size_t Words>
+static void seq_write(SeqSlot<Words>& slot, const uint64_t (&words)[Words], uint64_t next_seq)
+{
+    slot.seq.store(next_seq - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t i = 0; i < Words; ++i)
+    {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    slot.seq.store(next_seq, std::memory_order_release);
+}
+
+// Lecture seqlock : retourne le compteur stable observé, ou 0 si la copie est incohérente
+template <std::size_t Words>
+static uint64_t seq_read(const SeqSlot<Words>& slot, uint64_t (&words)[Words])
+{
+    const uint64_t before = slot.seq.load(std::memory_order_acquire);
+    if (before & 1U)
+    {
+        return 0;
+    }
+
+    for (std::size_t i = 0; i < Words; ++i)
+    {
+        words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t after = slot.seq.load(std::memory_order_relaxed);
+
+    return before == after ? before : 0;
+}
+
+// ============================================================================
+// ShmPublisher implementation
+// ============================================================================
+
+ShmPublisher::ShmPublisher(const std::string& name, uint32_t sensor_count, uint32_t ring_capacity)
+    : name_(name),
+      sensor_count_(sensor_count),
+      ring_capacity_(ring_capacity),
+      update_counts_(sensor_count, 0)
+{
+}
+
+ShmPublisher::~ShmPublisher()
+{
+    if (base_)
+    {
+        // Les lecteurs encore mappés voient l’arrêt : dernière mesure conservée,
+        // état Offline
+        for (uint32_t i = 0; i < sensor_count_; ++i)
+        {
+            uint64_t words[kSlotWords];
+            for (std::size_t w = 0; w < kSlotWords; ++w)
+            {
+                words[w] = slots_[i].words[w].load(std::memory_order_relaxed);
+            }
+            words[3] = static_cast<uint64_t>(SensorStatus::Offline) << 32;
+            words[4] = ++update_counts_[i];
+            seq_write(slots_[i], words, 2 * words[4]);
+        }
+
+        munmap(base_, size_);
+        base_ = nullptr;
+    }
+    if (fd_ >= 0)
+    {
+        close(fd_);
+        fd_ = -1;
+        shm_unlink(name_.c_str());
+    }
+}
+
+int ShmPublisher::open()
+{
+    if (base_)
+    {
+        return 0;
+    }
+
+    // Un segment laissé par une instance précédente est recréé à neuf
+    shm_unlink(name_.c_str());
+
+    fd_ = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd_ < 0)
+    {
+        return -errno;
+    }
+
+    size_ = segment_size(sensor_count_, ring_capacity_);
+    if (ftruncate(fd_, static_cast<off_t>(size_)) != 0)
+    {
+        const int err = errno;
+        close(fd_);
+        fd_ = -1;
+        shm_unlink(name_.c_str());
+        return -err;
+    }
+
+    void* base = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (base == MAP_FAILED)
+    {
+        const int err = errno;
+        close(fd_);
+        fd_ = -1;
+        shm_unlink(name_.c_str());
+        return -err;
+    }
+    base_ = base;
+
+    // Segment remis à zéro par ftruncate : on y construit les objets atomiques
+    auto* bytes = static_cast<unsigned char*>(base_);
+    header_ = new (bytes) Header{};
+    bytes += sizeof(Header);
+
+    slots_ = new (bytes) SeqSlot<kSlotWords>[sensor_count_]{};
+    bytes += sizeof(SeqSlot<kSlotWords>) * sensor_count_;
+
+    ring_ = ring_capacity_ > 0 ? new (bytes) SeqSlot<kRingWords>[ring_capacity_]{} : nullptr;
+
+    header_->version       = kShmVersion;
+    header_->sensor_count  = sensor_count_;
+    header_->ring_capacity = ring_capacity_;
+    header_->ring_head.store(0, std::memory_order_relaxed);
+    header_->epoch = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    header_->magic.store(kShmMagic, std::memory_order_release);
+
+    return 0;
+}
+
+void ShmPublisher::publish(uint32_t sensor, const Measurement& m, SensorStatus status, int32_t error_code)
+{
+    if (!base_ || sensor >= sensor_count_)
+    {
+        return;
+    }
+
+    const uint64_t count = ++update_counts_[sensor];
+    const uint64_t status_word = (static_cast<uint64_t>(status) << 32) |
+                                 static_cast<uint32_t>(error_code);
+
+    const uint64_t slot_words[kSlotWords] = {
+        double_bits(m.pressure_pa),
+        double_bits(m.temperature_c),
+        static_cast<uint64_t>(m.timestamp_ns),
+        status_word,
+        count,
+    };
+    seq_write(slots_[sensor], slot_words, 2 * count);
+
+    if (!ring_)
+    {
+        return;
+    }
+
+    // L’écrivain est seul à faire avancer ring_head : un simple load/store suffit
+    const uint64_t index = header_->ring_head.load(std::memory_order_relaxed);
+
+    const uint64_t ring_words[kRingWords] = {
+        double_bits(m.pressure_pa),
+        double_bits(m.temperature_c),
+        static_cast<uint64_t>(m.timestamp_ns),
+        (static_cast<uint64_t>(status) << 32) | sensor,
+    };
+
+    // Compteur pair propre à chaque passage : 2 · (index + 1)
+    seq_write(ring_[index % ring_capacity_], ring_words, 2 * (index + 1));
+    header_->ring_head.store(index + 1, std::memory_order_release);
+}
+
+// ============================================================================
+// ShmReader implementation
+// ============================================================================
+
+ShmReader::ShmReader(const std::string& name)
+    : name_(name)
+{
+}
+
+ShmReader::~ShmReader()
+{
+    release();
+}
+
+void ShmReader::release()
+{
+    if (base_)
+    {
+        munmap(const_cast<void*>(base_), size_);
+    }
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+    }
+
+    fd_     = -1;
+    base_   = nullptr;
+    size_   = 0;
+    header_ = nullptr;
+    slots_  = nullptr;
+    ring_   = nullptr;
+}
+
+int ShmReader::open()
+{
+    if (slots_)
+    {
+        // Segment toujours nommé : rien à faire. Supprimé (écrivain arrêté ou
+        // redémarré) : on passe au segment qui porte le nom, s’il existe.
+        struct stat st{};
+        if (fstat(fd_, &st) == 0 && st.st_nlink > 0)
+        {
+            return 0;
+        }
+    }
+
+    // Segment remplacé, ou tentative précédente incomplète (segment en cours
+    // de création) : on repart de zéro
+    release();
+
+    fd_ = shm_open(name_.c_str(), O_RDONLY, 0);
+    if (fd_ < 0)
+    {
+        const int err = -errno;
+        release();
+        return err;
+    }
+
+    struct stat st{};
+    if (fstat(fd_, &st) != 0)
+    {
+        const int err = -errno;
+        release();
+        return err;
+    }
+    if (static_cast<std::size_t>(st.st_size) < sizeof(Header))
+    {
+        release();
+        return -EPROTO;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0);
+    if (base == MAP_FAILED)
+    {
+        const int err = -errno;
+        release();
+        return err;
+    }
+    base_ = base;
+    size_ = size;
+
+    const auto* header = static_cast<const Header*>(base_);
+    if (header->magic.load(std::memory_order_acquire) != kShmMagic ||
+        header->version != kShmVersion ||
+        segment_size(header->sensor_count, header->ring_capacity) > size_)
+    {
+        release();
+        return -EPROTO;
+    }
+
+    // Membres publiés seulement une fois l’en-tête validé
+    header_ = header;
+    const auto* bytes = static_cast<const unsigned char*>(base_) + sizeof(Header);
+    slots_ = reinterpret_cast<const SeqSlot<kSlotWords>*>(bytes);
+    bytes += sizeof(SeqSlot<kSlotWords>) * header_->sensor_count;
+    ring_ = header_->ring_capacity > 0 ? reinterpret_cast<const SeqSlot<kRingWords>*>(bytes) : nullptr;
+
+    return 0;
+}
+
+uint32_t ShmReader::sensor_count() const
+{
+    return header_ ? header_->sensor_count : 0;
+}
+
+uint64_t ShmReader::epoch() const
+{
+    return header_ ? header_->epoch : 0;
+}
+
+bool ShmReader::read(uint32_t sensor, Snapshot& out, int max_retries) const
+{
+    if (!header_ || sensor >= header_->sensor_count)
+    {
+        return false;
+    }
+
+    uint64_t words[kSlotWords];
+    for (int attempt = 0; attempt <= max_retries; ++attempt)
+    {
+        const uint64_t seq = seq_read(slots_[sensor], words);
+        if (seq == 0 && slots_[sensor].seq.load(std::memory_order_relaxed) != 0)
+        {
+            continue;  // Écriture concurrente : on recommence
+        }
+
+        out.measurement.pressure_pa   = bits_double(words[0]);
+        out.measurement.temperature_c = bits_double(words[1]);
+        out.measurement.timestamp_ns  = static_cast<int64_t>(words[2]);
+        out.status       = static_cast<SensorStatus>(words[3] >> 32);
+        out.error_code   = static_cast<int32_t>(static_cast<uint32_t>(words[3]));
+        out.update_count = words[4];
+        return true;
+    }
+
+    return false;
+}
+
+uint64_t ShmReader::read_recent(std::vector<RingSample>& out, uint64_t& cursor) const
+{
+    if (!ring_)
+    {
+        return 0;
+    }
+
+    const uint64_t capacity = header_->ring_capacity;
+    const uint64_t head     = header_->ring_head.load(std::memory_order_acquire);
+
+    // Curseur d’un segment précédent, plus avancé que le nouveau : sans cela,
+    // plus aucun échantillon ne serait rendu
+    if (cursor > head)
+    {
+        cursor = 0;
+    }
+
+    uint64_t lost = 0;
+    if (head > capacity && cursor < head - capacity)
+    {
+        lost   = head - capacity - cursor;
+        cursor = head - capacity;
+    }
+
+    uint64_t words[kRingWords];
+    for (; cursor < head; ++cursor)
+    {
+        // Un compteur différent de 2 · (cursor + 1) signifie que l’entrée a été
+        // écrasée (ou est en cours d’écrasement) par un tour suivant.
+        if (seq_read(ring_[cursor % capacity], words) != 2 * (cursor + 1))
+        {
+            ++lost;
+            continue;
+        }
+
+        RingSample s{};
+        s.measurement.pressure_pa   = bits_double(words[0]);
+        s.measurement.temperature_c = bits_double(words[1]);
+        s.measurement.timestamp_ns  = static_cast<int64_t>(words[2]);
+        s.status = static_cast<SensorStatus>(words[3] >> 32);
+        s.sensor = static_cast<uint32_t>(words[3]);
+        out.push_back(s);
+    }
+
+    return lost;
+}
+
+}  // namespace bmp390
@@ -0,0 +1,348 @@
+#include "bmp390/telemetry_codec.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace bmp390
+{
+
+// "BMPT" : identifie un bloc produit par TelemetryEncoder
+static constexpr uint8_t kBlockMagic[4]  = {'B', 'M', 'P', 'T'};
+static constexpr uint8_t kBlockVersion   = 1;
+
+// Au-delà, le pas dépasse la précision d’un double
+static constexpr uint8_t kMaxDecimals    = 15;
+
+// Taille maximale d’un varint 64 bits
+static constexpr std::size_t kMaxVarintBytes = 10;
+
+// Borne des valeurs quantifiées : les deltas restent représentables sur 64 bits
+static constexpr double kMaxQuantized = 4.0e18;
+
+static double pow10(uint8_t decimals)
+{
+    double scale = 1.0;
+    for (uint8_t i = 0; i < decimals; ++i)
+    {
+        scale *= 10.0;
+    }
+    return scale;
+}
+
+static uint64_t zigzag(int64_t v)
+{
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v)
+{
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1U);
+}
+
+// Addition modulo 2^64 : un bloc corrompu ne provoque pas de débordement signé
+static int64_t wrapping_add(int64_t a, int64_t b)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+}
+
+static void put_varint(std::vector<uint8_t>& out, uint64_t v)
+{
+    while (v >= 0x80U)
+    {
+        out.push_back(static_cast<uint8_t>(v | 0x80U));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+// Retourne false si le varint dépasse `end` ou 10 octets
+static bool get_varint(const uint8_t*& p, const uint8_t* end, uint64_t& v)
+{
+    v = 0;
+    for (unsigned shift = 0; shift < 7 * kMaxVarintBytes; shift += 7)
+    {
+        if (p == end)
+        {
+            return false;
+        }
+        const uint8_t byte = *p++;
+        v |= static_cast<uint64_t>(byte & 0x7FU) << shift;
+        if ((byte & 0x80U) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void put_u16(uint8_t* p, uint16_t v)
+{
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+static void put_u32(uint8_t* p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+static uint16_t get_u16(const uint8_t* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Arrondi au plus proche (les horodatages peuvent être négatifs)
+static int64_t quantize_timestamp(int64_t ts_ns, int64_t quantum)
+{
+    return ts_ns >= 0 ? (ts_ns + quantum / 2) / quantum : -((-ts_ns + quantum / 2) / quantum);
+}
+
+// Code d’une valeur : 0 pour NaN, zigzag(delta) + 1 sinon ; `last` n’avance
+// que sur les valeurs valides
+static void put_value(std::vector<uint8_t>& col, double value, double scale, int64_t& last)
+{
+    if (std::isnan(value))
+    {
+        col.push_back(0);
+        return;
+    }
+
+    const double  scaled = std::min(std::max(value * scale, -kMaxQuantized), kMaxQuantized);
+    const int64_t q      = std::llround(scaled);
+    put_varint(col, zigzag(q - last) + 1);
+    last = q;
+}
+
+// ============================================================================
+// TelemetryEncoder implementation
+// ============================================================================
+
+TelemetryEncoder::TelemetryEncoder(const TelemetryConfig& config)
+    : config_(config)
+{
+    config_.pressure_decimals    = std::min(config_.pressure_decimals, kMaxDecimals);
+    config_.temperature_decimals = std::min(config_.temperature_decimals, kMaxDecimals);
+    config_.timestamp_quantum_ns = std::max<uint32_t>(config_.timestamp_quantum_ns, 1);
+    config_.block_samples        = std::max<uint16_t>(config_.block_samples, 1);
+
+    pressure_scale_    = pow10(config_.pressure_decimals);
+    temperature_scale_ = pow10(config_.temperature_decimals);
+
+    // Pire cas : un varint complet par valeur
+    const std::size_t capacity = static_cast<std::size_t>(config_.block_samples) * kMaxVarintBytes;
+    ts_col_.reserve(capacity);
+    press_col_.reserve(capacity);
+    temp_col_.reserve(capacity);
+}
+
+void TelemetryEncoder::push(const Measurement& m, std::vector<uint8_t>& out)
+{
+    // Horodatage : absolu, puis delta, puis delta de delta
+    const int64_t ts = quantize_timestamp(m.timestamp_ns, config_.timestamp_quantum_ns);
+    if (count_ == 0)
+    {
+        put_varint(ts_col_, zigzag(ts));
+    }
+    else
+    {
+        const int64_t delta = ts - last_ts_;
+        put_varint(ts_col_, zigzag(count_ == 1 ? delta : delta - last_ts_delta_));
+        last_ts_delta_ = delta;
+    }
+    last_ts_ = ts;
+
+    put_value(press_col_, m.pressure_pa, pressure_scale_, last_press_);
+    put_value(temp_col_, m.temperature_c, temperature_scale_, last_temp_);
+
+    if (++count_ == config_.block_samples)
+    {
+        flush(out);
+    }
+}
+
+void TelemetryEncoder::flush(std::vector<uint8_t>& out)
+{
+    if (count_ == 0)
+    {
+        return;
+    }
+
+    const std::size_t payload = ts_col_.size() + press_col_.size() + temp_col_.size();
+    const std::size_t start   = out.size();
+    out.resize(start + kTelemetryBlockHeaderSize);
+
+    uint8_t* h = out.data() + start;
+    std::copy(kBlockMagic, kBlockMagic + 4, h);
+    h[4] = kBlockVersion;
+    h[5] = config_.pressure_decimals;
+    h[6] = config_.temperature_decimals;
+    h[7] = 0;  // Réservé
+    put_u32(h + 8, config_.timestamp_quantum_ns);
+    put_u16(h + 12, count_);
+    put_u16(h + 14, 0);  // Réservé
+    put_u32(h + 16, static_cast<uint32_t>(payload));
+
+    out.insert(out.end(), ts_col_.begin(), ts_col_.end());
+    out.insert(out.end(), press_col_.begin(), press_col_.end());
+    out.insert(out.end(), temp_col_.begin(), temp_col_.end());
+
+    reset_block();
+}
+
+void TelemetryEncoder::reset_block()
+{
+    count_         = 0;
+    last_ts_       = 0;
+    last_ts_delta_ = 0;
+    last_press_    = 0;
+    last_temp_     = 0;
+
+    ts_col_.clear();
+    press_col_.clear();
+    temp_col_.clear();
+}
+
+// ============================================================================
+// Décodage
+// ============================================================================
+
+int read_block_header(const uint8_t* data, std::size_t size, TelemetryBlockHeader& header)
+{
+    if (size < kTelemetryBlockHeaderSize)
+    {
+        return kTelemetryErrTruncated;
+    }
+
+    if (!std::equal(kBlockMagic, kBlockMagic + 4, data) || data[4] != kBlockVersion)
+    {
+        return kTelemetryErrFormat;
+    }
+
+    header.version              = data[4];
+    header.pressure_decimals    = data[5];
+    header.temperature_decimals = data[6];
+    header.timestamp_quantum_ns = get_u32(data + 8);
+    header.sample_count         = get_u16(data + 12);
+    header.payload_bytes        = get_u32(data + 16);
+
+    if (header.pressure_decimals > kMaxDecimals || header.temperature_decimals > kMaxDecimals ||
+        header.timestamp_quantum_ns == 0 || header.sample_count == 0)
+    {
+        return kTelemetryErrFormat;
+    }
+
+    if (size - kTelemetryBlockHeaderSize < header.payload_bytes)
+    {
+        return kTelemetryErrTruncated;
+    }
+
+    return 0;
+}
+
+// Décode une colonne pression / température dans le champ `field` de chaque mesure
+static bool decode_values(const uint8_t*& p, const uint8_t* end, double scale,
+                          Measurement* out, std::size_t count, double Measurement::*field)
+{
+    int64_t last = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        uint64_t code = 0;
+        if (!get_varint(p, end, code))
+        {
+            return false;
+        }
+
+        if (code == 0)
+        {
+            out[i].*field = std::numeric_limits<double>::quiet_NaN();
+            continue;
+        }
+
+        last = wrapping_add(last, unzigzag(code - 1));
+        out[i].*field = static_cast<double>(last) / scale;
+    }
+    return true;
+}
+
+int decode_block(const uint8_t* data, std::size_t size, std::vector<Measurement>& out, std::size_t& consumed)
+{
+    TelemetryBlockHeader header{};
+    const int rslt = read_block_header(data, size, header);
+    if (rslt != 0)
+    {
+        return rslt;
+    }
+
+    const uint8_t*    p     = data + kTelemetryBlockHeaderSize;
+    const uint8_t*    end   = p + header.payload_bytes;
+    const std::size_t count = header.sample_count;
+    const std::size_t base  = out.size();
+    out.resize(base + count);
+    Measurement* m = out.data() + base;
+
+    // Horodatages
+    const int64_t quantum = header.timestamp_quantum_ns;
+    int64_t ts    = 0;
+    int64_t delta = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        uint64_t code = 0;
+        if (!get_varint(p, end, code))
+        {
+            out.resize(base);
+            return kTelemetryErrFormat;
+        }
+
+        if (i == 0)
+        {
+            ts = unzigzag(code);
+        }
+        else
+        {
+            delta = wrapping_add(i == 1 ? 0 : delta, unzigzag(code));
+            ts    = wrapping_add(ts, delta);
+        }
+        m[i].timestamp_ns = static_cast<int64_t>(static_cast<uint64_t>(ts) * static_cast<uint64_t>(quantum));
+    }
+
+    if (!decode_values(p, end, pow10(header.pressure_decimals), m, count, &Measurement::pressure_pa) ||
+        !decode_values(p, end, pow10(header.temperature_decimals), m, count, &Measurement::temperature_c) ||
+        p != end)
+    {
+        out.resize(base);
+        return kTelemetryErrFormat;
+    }
+
+    consumed = kTelemetryBlockHeaderSize + header.payload_bytes;
+    return 0;
+}
+
+int index_blocks(const uint8_t* data, std::size_t size, std::vector<std::size_t>& offsets)
+{
+    std::size_t offset = 0;
+    while (offset < size)
+    {
+        TelemetryBlockHeader header{};
+        const int rslt = read_block_header(data + offset, size - offset, header);
+        if (rslt != 0)
+        {
+            return rslt;
+        }
+
+        offsets.push_back(offset);
+        offset += kTelemetryBlockHeaderSize + header.payload_bytes;
+    }
+    return 0;
+}
+
+}  // namespace bmp390
@@ -0,0 +1,261 @@
+#include "bmp390/time_sync.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace bmp390
+{
+
+// Le compteur SENSORTIME est sur 24 bits.
+static constexpr uint32_t kSensorTimeMask = 0x00FFFFFFU;
+
+// Nombre de rejets consécutifs au-delà duquel on considère un saut d’horloge
+// (reset capteur, changement d’horloge hôte) plutôt qu’un point aberrant.
+static constexpr int kMaxConsecutiveRejects = 8;
+
+uint32_t odr_period_ticks(Config::OutputDataRate odr)
+{
+    return kSensorTimeTicksAt200Hz << static_cast<uint8_t>(odr);
+}
+
+// ============================================================================
+// SensorClock implementation
+// ============================================================================
+
+SensorClock::SensorClock(double forgetting, int64_t max_residual_ns)
+    : forgetting_(forgetting),
+      max_residual_ns_(max_residual_ns)
+{
+}
+
+uint64_t SensorClock::unwrap(uint32_t ticks)
+{
+    const uint32_t raw = ticks & kSensorTimeMask;
+
+    if (has_last_ && raw < last_raw_)
+    {
+        // Rebouclage du compteur 24 bits
+        epoch_ += static_cast<uint64_t>(kSensorTimeMask) + 1U;
+    }
+
+    has_last_ = true;
+    last_raw_ = raw;
+
+    return epoch_ + raw;
+}
+
+bool SensorClock::observe(uint32_t ticks, int64_t host_ns)
+{
+    const uint64_t ext = unwrap(ticks);
+
+    if (!has_ref_)
+    {
+        has_ref_   = true;
+        ref_ticks_ = ext;
+        ref_host_  = host_ns;
+    }
+
+    const double x = static_cast<double>(static_cast<int64_t>(ext - ref_ticks_));
+    const double y = static_cast<double>(host_ns - ref_host_);
+
+    if (locked_)
+    {
+        // La latence de lecture côté hôte est positive et très variable
+        // (préemption) : on écarte les points trop éloignés du modèle.
+        const double residual = y - (offset_ + rate_ * x);
+        if (std::fabs(residual) > static_cast<double>(max_residual_ns_))
+        {
+            if (++rejects_ < kMaxConsecutiveRejects)
+            {
+                return false;
+            }
+
+            // Trop de rejets consécutifs : on repart de ce point.
+            reset();
+            return observe(ticks, host_ns);
+        }
+    }
+    rejects_ = 0;
+
+    // Moindres carrés pondérés exponentiellement, forme centrée (Welford)
+    // pour rester précis quand x et y deviennent grands.
+    sw_  = forgetting_ * sw_ + 1.0;
+    cxx_ = forgetting_ * cxx_;
+    cxy_ = forgetting_ * cxy_;
+
+    const double dx = x - mx_;
+    mx_ += dx / sw_;
+    my_ += (y - my_) / sw_;
+    cxx_ += dx * (x - mx_);
+    cxy_ += dx * (y - my_);
+
+    if (cxx_ > 0.0)
+    {
+        rate_   = cxy_ / cxx_;
+        locked_ = true;
+    }
+
+    // Modèle : y = offset_ + rate_ * x, passant par le barycentre pondéré.
+    offset_ = my_ - rate_ * mx_;
+
+    return true;
+}
+
+int64_t SensorClock::to_host_ns(uint64_t ticks) const
+{
+    if (!has_ref_)
+    {
+        return 0;
+    }
+
+    const double x = static_cast<double>(static_cast<int64_t>(ticks - ref_ticks_));
+    return ref_host_ + static_cast<int64_t>(std::llround(offset_ + rate_ * x));
+}
+
+double SensorClock::drift_ppm() const
+{
+    if (!locked_)
+    {
+        return 0.0;
+    }
+    return (rate_ / kSensorTimeTickNs - 1.0) * 1e6;
+}
+
+void SensorClock::reset()
+{
+    has_last_ = false;
+    last_raw_ = 0;
+    epoch_    = 0;
+
+    has_ref_   = false;
+    ref_ticks_ = 0;
+    ref_host_  = 0;
+
+    sw_ = mx_ = my_ = cxx_ = cxy_ = 0.0;
+
+    offset_  = 0.0;
+    rate_    = kSensorTimeTickNs;
+    locked_  = false;
+    rejects_ = 0;
+}
+
+// ============================================================================
+// TimeAligner implementation
+// ============================================================================
+
+// Interpolation linéaire de la piste à l’instant t (NaN si t n’est pas encadré).
+static Measurement interpolate(const std::deque<Measurement>& track, int64_t t)
+{
+    Measurement m{};
+    m.timestamp_ns  = t;
+    m.pressure_pa   = std::numeric_limits<double>::quiet_NaN();
+    m.temperature_c = std::numeric_limits<double>::quiet_NaN();
+
+    if (track.empty() || track[0].timestamp_ns > t)
+    {
+        return m;
+    }
+
+    const Measurement& a = track[0];
+    if (a.timestamp_ns == t)
+    {
+        m.pressure_pa   = a.pressure_pa;
+        m.temperature_c = a.temperature_c;
+        return m;
+    }
+
+    if (track.size() < 2)
+    {
+        // Flux en retard : pas d’échantillon après t
+        return m;
+    }
+
+    const Measurement& b = track[1];
+    const double w = static_cast<double>(t - a.timestamp_ns) /
+                     static_cast<double>(b.timestamp_ns - a.timestamp_ns);
+
+    m.pressure_pa   = a.pressure_pa   + w * (b.pressure_pa   - a.pressure_pa);
+    m.temperature_c = a.temperature_c + w * (b.temperature_c - a.temperature_c);
+    return m;
+}
+
+TimeAligner::TimeAligner(std::size_t sensor_count, int64_t period_ns, int64_t max_latency_ns)
+    : tracks_(sensor_count),
+      period_ns_(period_ns > 0 ? period_ns : 1),
+      max_latency_ns_(max_latency_ns)
+{
+}
+
+void TimeAligner::push(std::size_t sensor, const Measurement& m)
+{
+    if (sensor >= tracks_.size() || m.timestamp_ns == 0)
+    {
+        return;
+    }
+
+    std::deque<Measurement>& track = tracks_[sensor];
+    if (!track.empty() && m.timestamp_ns <= track.back().timestamp_ns)
+    {
+        return;
+    }
+
+    track.push_back(m);
+
+    if (!started_)
+    {
+        // Première trame sur le premier multiple de la période après l’échantillon
+        started_ = true;
+        next_ns_ = ((m.timestamp_ns + period_ns_ - 1) / period_ns_) * period_ns_;
+    }
+
+    if (m.timestamp_ns > newest_ns_)
+    {
+        newest_ns_ = m.timestamp_ns;
+    }
+}
+
+bool TimeAligner::pop(AlignedFrame& out)
+{
+    if (!started_)
+    {
+        return false;
+    }
+
+    const int64_t t = next_ns_;
+
+    bool all_ready = true;
+    for (const auto& track : tracks_)
+    {
+        if (track.empty() || track.back().timestamp_ns < t)
+        {
+            all_ready = false;
+            break;
+        }
+    }
+
+    if (!all_ready && newest_ns_ < t + max_latency_ns_)
+    {
+        return false;
+    }
+
+    out.timestamp_ns = t;
+    out.samples.resize(tracks_.size());
+
+    for (std::size_t i = 0; i < tracks_.size(); ++i)
+    {
+        std::deque<Measurement>& track = tracks_[i];
+
+        // On ne garde que le dernier échantillon <= t (borne gauche pour t suivant)
+        while (track.size() >= 2 && track[1].timestamp_ns <= t)
+        {
+            track.pop_front();
+        }
+
+        out.samples[i] = interpolate(track, t);
+    }
+
+    next_ns_ += period_ns_;
+    return true;
+}
+
+}  // namespace bmp390
@@ -4,7 +4,7 @@
 // docs/ARCHITECTURE_MULTISENSOR.md.
 //
 // Attention :
-// - les callbacks I2C et Hdc3022Sensor sont laissés en pseudo-code,
+// - les callbacks I2C sont laissés en pseudo-code,
 // - la boucle principale est volontairement limitée (break) pour
 //   éviter une boucle infinie dans un exemple,
 // - le but est de montrer la structure, pas un binaire prêt à exécuter.
@@ -16,30 +16,13 @@
 #include <cstdint>
 
 #include "bmp390/bmp390_driver.hpp"
+#include "bmp390/shm_snapshot.hpp"
+#include "hdc3022/hdc3022_driver.hpp"
+#include "multisensor/bus_scheduler.hpp"
+#include "multisensor/sensor.hpp"
 
 using namespace bmp390;
-
-// -----------------------------------------------------------------------------
-// Interface abstraite ISensor
-// -----------------------------------------------------------------------------
-
-class ISensor
-{
-public:
-    virtual ~ISensor() = default;
-
-    /// @brief Met à jour les données internes du capteur (lecture hardware).
-    virtual void update() = 0;
-
-    /// @brief Retourne la température en °C, ou NaN si non disponible.
-    virtual double getTemperatureC() const
-    {
-        return std::nan(""); // Par défaut : pas de température
-    }
-
-    /// @brief Logge les données courantes sur le flux donné.
-    virtual void log(std::ostream& os) const = 0;
-};
+using multisensor::ISensor;
 
 // -----------------------------------------------------------------------------
 // Implémentation BMP390 : Bmp390Sensor
@@ -49,30 +32,59 @@ class Bmp390Sensor : public ISensor
 {
 public:
     Bmp390Sensor(const BusInterface& bus, uint8_t i2c_addr)
-        : bmp_(i2c_addr, bus, /*use_i2c=*/true)
+        : bus_(bus),
+          bmp_(i2c_addr, bus, /*use_i2c=*/true)
     {
         // Initialisation de base (erreurs ignorées ici pour simplifier l'exemple).
         // Dans un vrai système, il faudrait vérifier les codes de retour
         // de init() / configure() et réagir en conséquence.
         (void)bmp_.init();
 
+        // Mode forced : une conversion par cycle, déclenchée par trigger()
         Config cfg{};
         cfg.pressure_oversampling    = Config::Oversampling::X4;
         cfg.temperature_oversampling = Config::Oversampling::X1;
         cfg.odr                      = Config::OutputDataRate::Hz25;
         cfg.iir_filter               = Config::IirFilterCoeff::Coeff3;
+        cfg.power_mode               = Config::PowerMode::Forced;
 
         (void)bmp_.configure(cfg);
     }
 
     void update() override
     {
+        const uint32_t wait_us = trigger();
+        bus_.delay_us(wait_us);
+        collect();
+    }
+
+    uint32_t trigger() override
+    {
+        pending_ = bmp_.trigger_measurement() == 0;
+        if (!pending_)
+        {
+            valid_ = false;
+            return 0;
+        }
+        return bmp_.conversion_time_us();
+    }
+
+    void collect() override
+    {
+        // Déclenchement échoué : les registres contiennent encore la mesure
+        // précédente, on ne la republie pas comme valide
+        if (!pending_)
+        {
+            valid_ = false;
+            return;
+        }
+        pending_ = false;
+
         Measurement m{};
         int ret = bmp_.read_measurement(m);
         if (ret == 0)
         {
-            last_pressure_pa_   = m.pressure_pa;
-            last_temperature_c_ = m.temperature_c;
+            last_ = m;
             valid_ = true;
         }
         else
@@ -87,7 +99,13 @@ public:
         {
             return std::nan("");
         }
-        return last_temperature_c_;
+        return last_.temperature_c;
+    }
+
+    bool getMeasurement(Measurement& out) const override
+    {
+        out = last_;
+        return valid_;
     }
 
     void log(std::ostream& os) const override
@@ -98,49 +116,61 @@ public:
             return;
         }
 
-        os << "[BMP390] P=" << last_pressure_pa_ << " Pa, "
-           << "T=" << last_temperature_c_ << " °C\n";
+        os << "[BMP390] P=" << last_.pressure_pa << " Pa, "
+           << "T=" << last_.temperature_c << " °C\n";
     }
 
 private:
-    Bmp390 bmp_;
-    double last_pressure_pa_   = 0.0;
-    double last_temperature_c_ = 0.0;
-    bool   valid_              = false;
+    BusInterface bus_;
+    Bmp390       bmp_;
+    Measurement  last_{};
+    bool         pending_ = false;
+    bool         valid_   = false;
 };
 
 // -----------------------------------------------------------------------------
-// Implémentation HDC3022 (pseudo-code) : Hdc3022Sensor
+// Implémentation HDC3022 : Hdc3022Sensor
 // -----------------------------------------------------------------------------
 
 class Hdc3022Sensor : public ISensor
 {
 public:
-    Hdc3022Sensor(/* paramètres de bus / adresse I2C, etc. */)
+    Hdc3022Sensor(const BusInterface& bus, uint8_t i2c_addr)
+        : hdc_(i2c_addr, bus)
     {
-        // TODO: initialisation du capteur HDC3022 :
-        //  - ouverture du bus I2C
-        //  - configuration de l'adresse esclave
-        //  - reset / configuration des registres si nécessaire
+        // Soft reset + vérification de l'identifiant (erreurs ignorées ici)
+        (void)hdc_.init();
+        (void)hdc_.configure(hdc3022::Config{});
     }
 
     void update() override
     {
-        // TODO: lire les registres du HDC3022 via I2C
-        // Pseudo-code :
-        //  1) Envoyer une commande de mesure (temp + humidité)
-        //  2) Attendre la fin de conversion (delay)
-        //  3) Lire les valeurs brutes (temp_raw, hum_raw)
-        //  4) Appliquer les formules de conversion du datasheet :
-        //       temp_c = ...
-        //       hum_rh = ...
-        //  5) Mettre à jour last_temperature_c_ et last_humidity_rh_
-        //  6) Mettre valid_ = true si succès, false sinon
-
-        // Exemple placeholder :
-        last_temperature_c_ = 25.0;  // Valeur fictive
-        last_humidity_rh_   = 50.0;  // Valeur fictive
-        valid_              = true;
+        hdc3022::Measurement m{};
+        store(hdc_.measure(m), m);
+    }
+
+    uint32_t trigger() override
+    {
+        pending_ = hdc_.trigger_measurement() == 0;
+        if (!pending_)
+        {
+            valid_ = false;
+            return 0;
+        }
+        return hdc_.conversion_time_us();
+    }
+
+    void collect() override
+    {
+        if (!pending_)
+        {
+            valid_ = false;
+            return;
+        }
+        pending_ = false;
+
+        hdc3022::Measurement m{};
+        store(hdc_.read_measurement(m), m);
     }
 
     double getTemperatureC() const override
@@ -149,7 +179,17 @@ public:
         {
             return std::nan("");
         }
-        return last_temperature_c_;
+        return last_.temperature_c;
+    }
+
+    // Le segment partagé ne transporte que pression et température :
+    // l'humidité n'y est pas publiée (voir README de bmp390-lib, 5.5).
+    bool getMeasurement(Measurement& out) const override
+    {
+        out.pressure_pa   = std::nan("");
+        out.temperature_c = valid_ ? last_.temperature_c : std::nan("");
+        out.timestamp_ns  = last_.timestamp_ns;
+        return valid_;
     }
 
     void log(std::ostream& os) const override
@@ -160,18 +200,28 @@ public:
             return;
         }
 
-        os << "[HDC3022] T=" << last_temperature_c_ << " °C, "
-           << "RH=" << last_humidity_rh_ << " %\n";
+        os << "[HDC3022] T=" << last_.temperature_c << " °C, "
+           << "RH=" << last_.humidity_rh << " %\n";
     }
 
 private:
-    double last_temperature_c_ = 0.0;
-    double last_humidity_rh_   = 0.0;  // humidité relative (%)
-    bool   valid_              = false;
+    void store(int ret, const hdc3022::Measurement& m)
+    {
+        valid_ = ret == 0;
+        if (valid_)
+        {
+            last_ = m;
+        }
+    }
+
+    hdc3022::Hdc3022     hdc_;
+    hdc3022::Measurement last_{};
+    bool                 pending_ = false;
+    bool                 valid_   = false;
 };
 
 // -----------------------------------------------------------------------------
-// Callbacks bas niveau BMP390 (stubs d'exemple)
+// Callbacks bas niveau du bus I2C (stubs d'exemple)
 // -----------------------------------------------------------------------------
 
 int8_t my_i2c_read(uint8_t reg, uint8_t* data, uint16_t len)
@@ -192,6 +242,14 @@ int8_t my_i2c_write(uint8_t reg, const uint8_t* data, uint16_t len)
     return 0;
 }
 
+int8_t my_i2c_receive(uint8_t* data, uint16_t len)
+{
+    // TODO: implémenter la lecture I2C sans registre (read() sur /dev/i2c-*)
+    (void)data;
+    (void)len;
+    return 0;
+}
+
 void my_delay_us(uint32_t period)
 {
     // TODO: implémenter un délai en microsecondes (usleep, HAL_Delay_us, etc.)
@@ -204,22 +262,60 @@ void my_delay_us(uint32_t period)
 
 std::vector<std::unique_ptr<ISensor>> sensors;
 
+// Ordonnanceur du bus I2C commun : les conversions des capteurs se recouvrent
+multisensor::BusScheduler scheduler;
+
+// Dernier état de chaque capteur en mémoire partagée, pour les autres
+// processus (IHM, contrôleur, export) : lecture via bmp390::ShmReader.
+std::unique_ptr<ShmPublisher> publisher;
+
+// Dernière mesure valide de chaque capteur et cycles sans lecture réussie :
+// au-delà de kStaleAfterCycles, cette mesure est publiée comme périmée.
+std::vector<Measurement> last_valid;
+std::vector<uint32_t>    missed_cycles;
+constexpr uint32_t       kStaleAfterCycles = 3;
+
 void setupSensors()
 {
-    // Création de l'interface bus pour le BMP390
+    // Création de l'interface bus, commune au BMP390 et au HDC3022.
+    // Les callbacks réels doivent viser l'adresse de chaque capteur
+    // (ioctl I2C_SLAVE sous Linux) : en pratique, un jeu par adresse.
     BusInterface bus{};
     bus.read     = my_i2c_read;
     bus.write    = my_i2c_write;
+    bus.receive  = my_i2c_receive;
     bus.delay_us = my_delay_us;
 
-    // Adresse I2C du BMP390 (à adapter selon le câblage)
-    constexpr uint8_t bmp390_i2c_addr = 0x76;
+    // Adresses I2C (à adapter selon le câblage)
+    constexpr uint8_t bmp390_i2c_addr  = 0x76;
+    constexpr uint8_t hdc3022_i2c_addr = 0x44;
 
     // Capteur BMP390
     sensors.push_back(std::make_unique<Bmp390Sensor>(bus, bmp390_i2c_addr));
 
-    // Capteur HDC3022 (pseudo-code, pas de paramètres concrets ici)
-    sensors.push_back(std::make_unique<Hdc3022Sensor>());
+    // Capteur HDC3022
+    sensors.push_back(std::make_unique<Hdc3022Sensor>(bus, hdc3022_i2c_addr));
+
+    for (const auto& sensor : sensors)
+    {
+        scheduler.add(*sensor);
+    }
+
+    Measurement none{};
+    none.pressure_pa   = std::nan("");
+    none.temperature_c = std::nan("");
+    last_valid.assign(sensors.size(), none);
+    missed_cycles.assign(sensors.size(), 0);
+
+    // Segment partagé : un emplacement par capteur + anneau des 1024 derniers échantillons
+    publisher = std::make_unique<ShmPublisher>("/mirega_sensors",
+                                               static_cast<uint32_t>(sensors.size()),
+                                               /*ring_capacity=*/1024);
+    if (publisher->open() != 0)
+    {
+        std::cout << "[GLOBAL] Segment partagé indisponible, publication désactivée" << std::endl;
+        publisher.reset();
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -247,14 +343,37 @@ void mainLoop()
         double max_temp_seen = -1e9;
         bool   alarm         = false;
 
-        for (const auto& sensor : sensors)
+        // 1) Mise à jour des données : déclenchement de tous les capteurs,
+        //    puis collecte de chacun dès la fin de sa conversion
+        scheduler.runCycle();
+
+        for (std::size_t i = 0; i < sensors.size(); ++i)
         {
-            // 1) Mise à jour des données
-            sensor->update();
+            const auto& sensor = sensors[i];
 
-            // 2) Logging
+            // 2) Logging + publication en mémoire partagée
             sensor->log(std::cout);
 
+            if (publisher)
+            {
+                Measurement m{};
+                if (sensor->getMeasurement(m))
+                {
+                    last_valid[i]    = m;
+                    missed_cycles[i] = 0;
+                    publisher->publish(static_cast<uint32_t>(i), m, SensorStatus::Ok);
+                }
+                else
+                {
+                    // Lecture en échec : la dernière mesure valide reste publiée,
+                    // en ReadError puis en Stale une fois le délai dépassé
+                    missed_cycles[i] += 1;
+                    publisher->publish(static_cast<uint32_t>(i), last_valid[i],
+                                       missed_cycles[i] > kStaleAfterCycles ? SensorStatus::Stale
+                                                                            : SensorStatus::ReadError);
+                }
+            }
+
             // 3) Récupération de la température (si dispo)
             double t = sensor->getTemperatureC();
             if (!std::isnan(t))
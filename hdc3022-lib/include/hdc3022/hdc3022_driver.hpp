@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+
+#include "bmp390/bmp390_driver.hpp"  // bmp390::BusInterface
+
+namespace hdc3022
+{
+
+/// Interface bus commune aux drivers du dépôt (callbacks fournis par l’application).
+using BusInterface = bmp390::BusInterface;
+
+/// Codes de retour (0 = succès), alignés sur les codes BMP3_E_* équivalents.
+constexpr int kOk             = 0;
+constexpr int kErrNullPtr     = -1;  ///< Capteur non initialisé ou callback bus manquant.
+constexpr int kErrCommFail    = -2;  ///< Échec du transfert (dont NACK : conversion en cours).
+constexpr int kErrCrc         = -3;  ///< CRC d’un mot reçu invalide.
+constexpr int kErrDevNotFound = -4;  ///< Identifiant fabricant inattendu.
+
+/**
+ * @brief Configuration de la mesure HDC3022.
+ */
+struct Config
+{
+    /// Mode basse consommation : compromis bruit / durée de conversion.
+    enum class LowPowerMode : uint8_t
+    {
+        Lpm0 = 0,  ///< Bruit minimal, conversion la plus longue (12,5 ms max).
+        Lpm1 = 1,  ///< 7,5 ms max.
+        Lpm2 = 2,  ///< 5 ms max.
+        Lpm3 = 3   ///< Bruit maximal, conversion la plus courte (3,7 ms max).
+    };
+
+    /// Mode de conversion (par défaut LPM0).
+    LowPowerMode low_power_mode = LowPowerMode::Lpm0;
+};
+
+/**
+ * @brief Mesure température + humidité relative.
+ */
+struct Measurement
+{
+    /// Température en degrés Celsius.
+    double temperature_c = 0.0;
+
+    /// Humidité relative en %.
+    double humidity_rh = 0.0;
+
+    /// Horodatage hôte monotone (ns, std::chrono::steady_clock), 0 si inconnu.
+    int64_t timestamp_ns = 0;
+};
+
+/**
+ * @brief Driver du capteur température / humidité TI HDC3022 (mode trigger-on-demand).
+ *
+ * Le HDC3022 est piloté par commandes 16 bits : une commande lance une
+ * conversion, le résultat (6 octets avec CRC) se lit ensuite sans adresse de
+ * registre via BusInterface::receive. Les deux phases sont exposées
+ * séparément pour libérer le bus pendant la conversion.
+ */
+class Hdc3022
+{
+public:
+    /**
+     * @brief Construit un objet HDC3022.
+     *
+     * @param i2c_addr Adresse 7 bits (0x44 à 0x47 selon ADDR/ADDR1), portée par les callbacks.
+     * @param bus      Interface bus (write, receive et delay_us requis).
+     */
+    Hdc3022(uint8_t i2c_addr, const BusInterface& bus);
+
+    /**
+     * @brief Soft reset puis vérification de l’identifiant fabricant (0x3000).
+     *
+     * @return 0 si succès, valeur négative en cas d’erreur.
+     */
+    int init();
+
+    /**
+     * @brief Mémorise la configuration utilisée par les conversions suivantes.
+     *
+     * @return 0 (aucun accès bus en mode trigger-on-demand).
+     */
+    int configure(const Config& config);
+
+    /**
+     * @brief Lance une conversion température + humidité.
+     *
+     * Retourne dès la commande envoyée ; le résultat est lisible par
+     * read_measurement() après conversion_time_us().
+     *
+     * @return 0 si succès, valeur négative en cas d’erreur.
+     */
+    int trigger_measurement();
+
+    /**
+     * @brief Lit le résultat de la dernière conversion.
+     *
+     * Le capteur refuse la lecture (NACK, kErrCommFail) tant que la
+     * conversion n’est pas terminée.
+     *
+     * @param out Structure de sortie (horodatée à la réception).
+     * @return 0 si succès, valeur négative en cas d’erreur.
+     */
+    int read_measurement(Measurement& out);
+
+    /**
+     * @brief Mesure bloquante : trigger, attente de conversion, lecture.
+     *
+     * @param out Structure de sortie.
+     * @return 0 si succès, valeur négative en cas d’erreur.
+     */
+    int measure(Measurement& out);
+
+    /**
+     * @brief Durée maximale de conversion pour le mode configuré.
+     *
+     * @return Durée en microsecondes.
+     */
+    uint32_t conversion_time_us() const;
+
+    /// Adresse I2C du capteur.
+    uint8_t address() const { return i2c_addr_; }
+
+private:
+    /// Envoie une commande 16 bits (MSB en "registre", LSB en donnée).
+    int send_command(uint16_t command);
+
+    uint8_t      i2c_addr_;
+    BusInterface bus_;
+    Config       config_;
+};
+
+/**
+ * @brief CRC-8 du HDC3022 (polynôme 0x31, valeur initiale 0xFF).
+ *
+ * @param data Octets couverts par le CRC (2 pour un mot de mesure).
+ * @param len  Nombre d’octets.
+ */
+uint8_t crc8(const uint8_t* data, uint16_t len);
+
+}  // namespace hdc3022
@@ -0,0 +1,197 @@
+#include "hdc3022/hdc3022_driver.hpp"
+
+#include <chrono>
+
+namespace hdc3022
+{
+
+// Commandes du datasheet (trigger-on-demand, reset, identifiant fabricant)
+static constexpr uint16_t kCmdTriggerLpm0     = 0x2400;
+static constexpr uint16_t kCmdTriggerLpm1     = 0x240B;
+static constexpr uint16_t kCmdTriggerLpm2     = 0x2416;
+static constexpr uint16_t kCmdTriggerLpm3     = 0x24FF;
+static constexpr uint16_t kCmdSoftReset       = 0x30A2;
+static constexpr uint16_t kCmdManufacturerId  = 0x3781;
+
+static constexpr uint16_t kManufacturerIdTi   = 0x3000;
+
+// Durée de reprise après soft reset (µs)
+static constexpr uint32_t kSoftResetTimeUs    = 3000;
+
+// Horloge hôte monotone utilisée pour l’horodatage des mesures
+static int64_t host_now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static uint16_t trigger_command(Config::LowPowerMode mode)
+{
+    switch (mode)
+    {
+        case Config::LowPowerMode::Lpm0: return kCmdTriggerLpm0;
+        case Config::LowPowerMode::Lpm1: return kCmdTriggerLpm1;
+        case Config::LowPowerMode::Lpm2: return kCmdTriggerLpm2;
+        case Config::LowPowerMode::Lpm3: return kCmdTriggerLpm3;
+        default:                         return kCmdTriggerLpm0;
+    }
+}
+
+// Mot 16 bits suivi de son CRC ; retourne false si le CRC est invalide
+static bool parse_word(const uint8_t* bytes, uint16_t& word)
+{
+    if (crc8(bytes, 2) != bytes[2])
+    {
+        return false;
+    }
+    word = static_cast<uint16_t>((static_cast<uint16_t>(bytes[0]) << 8) | bytes[1]);
+    return true;
+}
+
+uint8_t crc8(const uint8_t* data, uint16_t len)
+{
+    uint8_t crc = 0xFF;
+    for (uint16_t i = 0; i < len; ++i)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 0x80U) ? static_cast<uint8_t>((crc << 1) ^ 0x31U) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// ============================================================================
+// Hdc3022 implementation
+// ============================================================================
+
+Hdc3022::Hdc3022(uint8_t i2c_addr, const BusInterface& bus)
+    : i2c_addr_(i2c_addr),
+      bus_(bus)
+{
+}
+
+int Hdc3022::init()
+{
+    if (!bus_.write || !bus_.receive || !bus_.delay_us)
+    {
+        return kErrNullPtr;
+    }
+
+    int rslt = send_command(kCmdSoftReset);
+    if (rslt != kOk)
+    {
+        return rslt;
+    }
+    bus_.delay_us(kSoftResetTimeUs);
+
+    rslt = send_command(kCmdManufacturerId);
+    if (rslt != kOk)
+    {
+        return rslt;
+    }
+
+    uint8_t reply[3] = {};
+    if (bus_.receive(reply, sizeof(reply)) != 0)
+    {
+        return kErrCommFail;
+    }
+
+    uint16_t id = 0;
+    if (!parse_word(reply, id))
+    {
+        return kErrCrc;
+    }
+
+    return id == kManufacturerIdTi ? kOk : kErrDevNotFound;
+}
+
+int Hdc3022::configure(const Config& config)
+{
+    config_ = config;
+    return kOk;
+}
+
+int Hdc3022::trigger_measurement()
+{
+    return send_command(trigger_command(config_.low_power_mode));
+}
+
+int Hdc3022::read_measurement(Measurement& out)
+{
+    if (!bus_.receive)
+    {
+        return kErrNullPtr;
+    }
+
+    // Température (MSB, LSB, CRC) puis humidité (MSB, LSB, CRC)
+    uint8_t reply[6] = {};
+    if (bus_.receive(reply, sizeof(reply)) != 0)
+    {
+        return kErrCommFail;
+    }
+
+    uint16_t raw_t  = 0;
+    uint16_t raw_rh = 0;
+    if (!parse_word(reply, raw_t) || !parse_word(reply + 3, raw_rh))
+    {
+        return kErrCrc;
+    }
+
+    // Formules de conversion du datasheet
+    out.temperature_c = -45.0 + 175.0 * static_cast<double>(raw_t) / 65535.0;
+    out.humidity_rh   = 100.0 * static_cast<double>(raw_rh) / 65535.0;
+    out.timestamp_ns  = host_now_ns();
+
+    return kOk;
+}
+
+int Hdc3022::measure(Measurement& out)
+{
+    int rslt = trigger_measurement();
+    if (rslt != kOk)
+    {
+        return rslt;
+    }
+
+    if (!bus_.delay_us)
+    {
+        return kErrNullPtr;
+    }
+    bus_.delay_us(conversion_time_us());
+
+    return read_measurement(out);
+}
+
+uint32_t Hdc3022::conversion_time_us() const
+{
+    switch (config_.low_power_mode)
+    {
+        case Config::LowPowerMode::Lpm0: return 12500;
+        case Config::LowPowerMode::Lpm1: return 7500;
+        case Config::LowPowerMode::Lpm2: return 5000;
+        case Config::LowPowerMode::Lpm3: return 3700;
+        default:                         return 12500;
+    }
+}
+
+int Hdc3022::send_command(uint16_t command)
+{
+    if (!bus_.write)
+    {
+        return kErrNullPtr;
+    }
+
+    // Sur le fil, "registre" + 1 octet de donnée = commande 16 bits MSB en tête
+    const uint8_t lsb = static_cast<uint8_t>(command & 0xFFU);
+    if (bus_.write(static_cast<uint8_t>(command >> 8), &lsb, 1) != 0)
+    {
+        return kErrCommFail;
+    }
+
+    return kOk;
+}
+
+}  // namespace hdc3022
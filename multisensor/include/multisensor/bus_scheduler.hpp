@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "multisensor/sensor.hpp"
+
+namespace multisensor
+{
+
+/**
+ * @brief Source de temps du scheduler (microsecondes, monotone).
+ *
+ * Callbacks nuls : std::chrono::steady_clock et std::this_thread::sleep_until.
+ * Un temps virtuel peut être injecté pour la simulation (benchmarks).
+ */
+struct SchedulerClock
+{
+    /// Instant courant en microsecondes.
+    int64_t (*now_us)() = nullptr;
+
+    /// Attend jusqu’à l’instant `deadline_us`.
+    void (*sleep_until_us)(int64_t deadline_us) = nullptr;
+};
+
+/**
+ * @brief Ordonnanceur des capteurs d’un même bus, en deux phases.
+ *
+ * Un cycle déclenche tous les capteurs (trigger), puis collecte chacun dès
+ * que sa conversion est terminée : les conversions se recouvrent entre elles
+ * et avec les transferts vers les autres capteurs, au lieu de bloquer le bus
+ * l’une après l’autre comme update(). Le cycle dure environ la somme des
+ * transferts plus la plus longue conversion, au lieu de la somme de tout.
+ *
+ * Les déclenchements sont ordonnés par conversion décroissante (mesurée au
+ * cycle précédent) : les capteurs lents démarrent en premier.
+ *
+ * Un scheduler par bus physique : les capteurs ne sont jamais appelés
+ * depuis plusieurs threads.
+ */
+class BusScheduler
+{
+public:
+    explicit BusScheduler(const SchedulerClock& clock = SchedulerClock{});
+
+    /// Ajoute un capteur du bus (non possédé, doit survivre au scheduler).
+    void add(ISensor& sensor);
+
+    /// Nombre de capteurs ordonnancés.
+    std::size_t size() const { return entries_.size(); }
+
+    /// Exécute un cycle complet : chaque capteur est déclenché puis collecté une fois.
+    void runCycle();
+
+private:
+    struct Entry
+    {
+        ISensor* sensor   = nullptr;
+        uint32_t delay_us = 0;   ///< Délai annoncé au dernier trigger().
+        int64_t  ready_us = 0;   ///< Instant à partir duquel collect() est possible.
+    };
+
+    int64_t now() const;
+    void    sleepUntil(int64_t deadline_us) const;
+
+    SchedulerClock     clock_;
+    std::vector<Entry> entries_;
+
+    /// Ordre de déclenchement puis de collecte (indices dans entries_),
+    /// recalculés à chaque cycle sans allocation.
+    std::vector<std::size_t> order_;
+    std::vector<std::size_t> collect_order_;
+};
+
+}  // namespace multisensor
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+
+#include "bmp390/bmp390_driver.hpp"  // bmp390::Measurement
+
+namespace multisensor
+{
+
+/**
+ * @brief Interface abstraite commune à tous les capteurs.
+ *
+ * Deux façons de lire un capteur :
+ *  - update() : lecture complète et bloquante (boucle série simple) ;
+ *  - trigger() puis collect() : contrat en deux phases, qui laisse le bus
+ *    libre pendant la conversion (voir BusScheduler).
+ *
+ * Un capteur sans conversion à attendre peut ne fournir que update() :
+ * trigger() l’appelle alors et annonce un délai nul.
+ */
+class ISensor
+{
+public:
+    virtual ~ISensor() = default;
+
+    /// @brief Met à jour les données internes du capteur (lecture hardware).
+    virtual void update() = 0;
+
+    /**
+     * @brief Phase 1 : lance une conversion (court transfert bus, sans attente).
+     *
+     * @return Délai minimal avant collect(), en microsecondes.
+     */
+    virtual uint32_t trigger()
+    {
+        update();
+        return 0;
+    }
+
+    /**
+     * @brief Phase 2 : lit le résultat de la conversion lancée par trigger().
+     *
+     * Toujours appelée après trigger(), même en cas d’échec de celui-ci : la
+     * mesure doit alors être signalée invalide (les registres du capteur
+     * contiennent encore la conversion précédente).
+     */
+    virtual void collect() {}
+
+    /// @brief Retourne la température en °C, ou NaN si non disponible.
+    virtual double getTemperatureC() const
+    {
+        return std::nan(""); // Par défaut : pas de température
+    }
+
+    /// @brief Logge les données courantes sur le flux donné.
+    virtual void log(std::ostream& os) const = 0;
+
+    /// @brief Remplit la dernière mesure (NaN pour les grandeurs non fournies).
+    /// @return true si la dernière lecture est valide.
+    virtual bool getMeasurement(bmp390::Measurement& out) const
+    {
+        out.pressure_pa   = std::nan("");
+        out.temperature_c = getTemperatureC();
+        return !std::isnan(out.temperature_c);
+    }
+};
+
+}  // namespace multisensor
@@ -0,0 +1,78 @@
+#include "multisensor/bus_scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace multisensor
+{
+
+BusScheduler::BusScheduler(const SchedulerClock& clock)
+    : clock_(clock)
+{
+}
+
+void BusScheduler::add(ISensor& sensor)
+{
+    Entry e{};
+    e.sensor = &sensor;
+    entries_.push_back(e);
+    order_.push_back(entries_.size() - 1);
+    collect_order_.push_back(entries_.size() - 1);
+}
+
+void BusScheduler::runCycle()
+{
+    // 1) Déclenchements, conversions les plus longues en premier (l’index
+    //    départage les égalités : ordre stable, sans le tampon de stable_sort)
+    std::sort(order_.begin(), order_.end(), [this](std::size_t a, std::size_t b) {
+        return entries_[a].delay_us != entries_[b].delay_us ? entries_[a].delay_us > entries_[b].delay_us : a < b;
+    });
+
+    for (std::size_t idx : order_)
+    {
+        Entry& e   = entries_[idx];
+        e.delay_us = e.sensor->trigger();
+        e.ready_us = now() + static_cast<int64_t>(e.delay_us);
+    }
+
+    // 2) Collectes dans l’ordre de fin de conversion, en n’attendant que si
+    //    aucune conversion n’est terminée
+    collect_order_ = order_;
+    std::sort(collect_order_.begin(), collect_order_.end(), [this](std::size_t a, std::size_t b) {
+        return entries_[a].ready_us != entries_[b].ready_us ? entries_[a].ready_us < entries_[b].ready_us : a < b;
+    });
+
+    for (std::size_t idx : collect_order_)
+    {
+        const Entry& e = entries_[idx];
+        if (e.ready_us > now())
+        {
+            sleepUntil(e.ready_us);
+        }
+        e.sensor->collect();
+    }
+}
+
+int64_t BusScheduler::now() const
+{
+    if (clock_.now_us)
+    {
+        return clock_.now_us();
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void BusScheduler::sleepUntil(int64_t deadline_us) const
+{
+    if (clock_.sleep_until_us)
+    {
+        clock_.sleep_until_us(deadline_us);
+        return;
+    }
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::microseconds(deadline_us)));
+}
+
+}  // namespace multisensor